@@ -8,8 +8,14 @@
  * Created: Jun 06, 2025
  */
 
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+// clock_gettime() for the EC_WCET_NOW() counter fallback
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "err_core.h"
 #include "assert.h"
+#include "string.h"
 
 #if EC_TICK_FROM_FUNC
 
@@ -39,6 +45,331 @@ void EC_tick_variable_register(EC_TIME_t *Variable)
 
 #endif
 
+#if (EC_USE_WCET || EC_USE_CHECK_PROFILE) && !defined(EC_WCET_NOW)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define EC_WCET_NOW() ((uint64_t)__builtin_ia32_rdtsc())
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+static inline uint64_t EC_wcetCounter(void)
+{
+    uint64_t value;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+}
+#define EC_WCET_NOW() EC_wcetCounter()
+#elif defined(__unix__) || defined(__APPLE__)
+#include "time.h"
+static inline uint64_t EC_wcetCounter(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#define EC_WCET_NOW() EC_wcetCounter()
+#else
+#error "EC_USE_WCET/EC_USE_CHECK_PROFILE: no built-in counter for this target, define EC_WCET_NOW()"
+#endif
+#endif
+
+#if EC_USE_USDT && defined(__linux__)
+#include "sys/sdt.h"
+#define EC_USDT 1
+#define EC_PROBE2(Name, A1, A2) DTRACE_PROBE2(err_core, Name, A1, A2)
+#define EC_PROBE3(Name, A1, A2, A3) DTRACE_PROBE3(err_core, Name, A1, A2, A3)
+#define EC_PROBE4(Name, A1, A2, A3, A4) DTRACE_PROBE4(err_core, Name, A1, A2, A3, A4)
+#else
+#define EC_USDT 0
+#define EC_PROBE2(Name, A1, A2) ((void)0)
+#define EC_PROBE3(Name, A1, A2, A3) ((void)0)
+#define EC_PROBE4(Name, A1, A2, A3, A4) ((void)0)
+#endif
+
+/** Transition points are only tracked when a consumer is compiled in */
+#define EC_TRACK_TRANSITIONS (EC_USE_TRANSITION_HOOK || EC_USE_STATS || EC_USDT)
+
+#if EC_USE_STATS
+#if defined(__GNUC__) || defined(__clang__)
+#define EC_MEMORY_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define EC_MEMORY_BARRIER() ((void)0)
+#endif
+
+/**
+ * Marks the start (odd sequence) and end (even sequence) of a statistics update.
+ * Brackets only the stores of one update - never ErrFunc or user callbacks - so readers rarely collide.
+ */
+#define EC_STATS_WRITE_BEGIN(Instance)                                                                                 \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        (Instance)->StatsSeq++;                                                                                        \
+        EC_MEMORY_BARRIER();                                                                                           \
+    } while (0)
+#define EC_STATS_WRITE_END(Instance)                                                                                   \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        EC_MEMORY_BARRIER();                                                                                           \
+        (Instance)->StatsSeq++;                                                                                        \
+    } while (0)
+
+/**
+ * Closes an open warning period.
+ */
+static inline void EC_stats_endWarning(EC_stats_t *Stats, EC_TIME_t Tick)
+{
+    if (Stats->Flags & EC_STATS_IN_WARNING)
+    {
+        Stats->TimeInWarning += (EC_TIME_t)(Tick - Stats->WarningSince);
+        Stats->Flags &= (uint8_t)~EC_STATS_IN_WARNING;
+    }
+}
+
+/**
+ * Closes an open presence period. Observed = 0 when the check stops running (latch,
+ * suppression): the following absence is not measured, so no recurrence sample is taken.
+ */
+static void EC_stats_endPresence(EC_stats_t *Stats, EC_TIME_t Tick, uint8_t Observed)
+{
+    if (!(Stats->Flags & EC_STATS_PRESENT))
+    {
+        return;
+    }
+
+    EC_TIME_t presence = (EC_TIME_t)(Tick - Stats->PresenceSince);
+    if (presence > Stats->MaxPresence)
+    {
+        Stats->MaxPresence = presence;
+    }
+    Stats->Flags &= (uint8_t)~EC_STATS_PRESENT;
+#if EC_USE_HISTOGRAMS
+    EC_histogram_add(&Stats->PresenceHist, presence);
+    Stats->LastPresenceEnd = Tick;
+    if (Observed)
+    {
+        Stats->Flags |= EC_STATS_ENDED;
+    }
+    else
+    {
+        Stats->Flags &= (uint8_t)~EC_STATS_ENDED;
+    }
+#else
+    (void)Observed;
+#endif
+}
+
+/**
+ * Updates the statistics of one error at a transition point.
+ */
+static void EC_stats_transition(EC_stats_t *Stats, EC_transition_t Transition, EC_TIME_t Tick)
+{
+    switch (Transition)
+    {
+    case EC_TRANSITION_WARNING:
+        Stats->WarningCount++;
+        if (!(Stats->Flags & EC_STATS_IN_WARNING))
+        {
+            Stats->Flags |= EC_STATS_IN_WARNING;
+            Stats->WarningSince = Tick;
+        }
+        break;
+    case EC_TRANSITION_ERROR:
+        Stats->ErrorCount++;
+        EC_stats_endWarning(Stats, Tick);
+        // The check is not called while the error is latched - the presence ends here
+        EC_stats_endPresence(Stats, Tick, 0);
+        if (!(Stats->Flags & EC_STATS_IN_ERROR))
+        {
+            Stats->Flags |= EC_STATS_IN_ERROR;
+            Stats->ErrorSince = Tick;
+        }
+        break;
+    case EC_TRANSITION_RESET:
+        EC_stats_endWarning(Stats, Tick);
+        break;
+    default:
+        EC_stats_endWarning(Stats, Tick);
+        if (Stats->Flags & EC_STATS_IN_ERROR)
+        {
+            Stats->TimeInError += (EC_TIME_t)(Tick - Stats->ErrorSince);
+            Stats->Flags &= (uint8_t)~EC_STATS_IN_ERROR;
+        }
+        break;
+    }
+}
+#else
+#define EC_STATS_WRITE_BEGIN(Instance) ((void)0)
+#define EC_STATS_WRITE_END(Instance) ((void)0)
+#endif
+
+#if EC_TRACK_TRANSITIONS
+/**
+ * Dispatches one transition to the compiled-in consumers.
+ */
+static void EC_onTransition(EC_instance_t *Instance, uint8_t ErrorNumber, EC_transition_t Transition, EC_TIME_t Tick)
+{
+#if EC_USDT
+    uint64_t usdt_tick = (uint64_t)Tick;
+    uint8_t usdt_count = Instance->RuntimeData[ErrorNumber].WarningCnt;
+
+    // One probe per transition type, so tracers attach to exactly what they need
+    switch (Transition)
+    {
+    case EC_TRANSITION_WARNING:
+        EC_PROBE4(warning, Instance, ErrorNumber, usdt_tick, usdt_count);
+        break;
+    case EC_TRANSITION_ERROR:
+        EC_PROBE4(error, Instance, ErrorNumber, usdt_tick, usdt_count);
+        break;
+    case EC_TRANSITION_RESET:
+        EC_PROBE4(reset, Instance, ErrorNumber, usdt_tick, usdt_count);
+        break;
+    default:
+        EC_PROBE4(clear, Instance, ErrorNumber, usdt_tick, usdt_count);
+        break;
+    }
+#endif
+#if EC_USE_STATS
+    if (NULL != Instance->Stats)
+    {
+        EC_STATS_WRITE_BEGIN(Instance);
+        EC_stats_transition(&Instance->Stats[ErrorNumber], Transition, Tick);
+        EC_STATS_WRITE_END(Instance);
+    }
+#endif
+#if EC_USE_TRANSITION_HOOK
+    if (NULL != Instance->OnTransition)
+    {
+        Instance->OnTransition(Instance->TransitionContext, Instance, ErrorNumber, Transition, Tick);
+    }
+#endif
+}
+
+#define EC_EMIT_TRANSITION(Instance, Index, Transition, Tick) EC_onTransition((Instance), (Index), (Transition), (Tick))
+#else
+#define EC_EMIT_TRANSITION(Instance, Index, Transition, Tick) ((void)(Transition))
+#endif
+
+#if EC_USE_WCET
+/**
+ * Adds one EC_poll() duration to the accumulators of the instance.
+ */
+static void EC_wcetRecord(EC_instance_t *Instance, uint64_t Duration, uint64_t ErrorReg, uint64_t WarningReg)
+{
+    EC_wcet_t *wcet = Instance->Wcet;
+
+    wcet->Calls++;
+    wcet->Total += Duration;
+    EC_histogram_add(&wcet->Hist, Duration);
+
+    if (Duration < wcet->Min)
+    {
+        wcet->Min = Duration;
+    }
+    if (Duration > wcet->Max)
+    {
+        wcet->Max = Duration;
+        wcet->WorstCall = wcet->Calls;
+        wcet->WorstTick = EC_GET_TICK;
+        wcet->WorstErrorReg = ErrorReg;
+        wcet->WorstWarningReg = WarningReg;
+        wcet->WorstErrorRegOut = Instance->ErrorReg;
+        wcet->WorstWarningRegOut = Instance->WarningReg;
+    }
+}
+#endif
+
+#if EC_USE_JITTER
+/**
+ * Accounts the interval since the previous poll, registers the starved error on a late poll.
+ */
+static void EC_jitterRecord(EC_instance_t *Instance, EC_TIME_t Tick)
+{
+    EC_jitter_t *jitter = Instance->Jitter;
+    EC_TIME_t gap = (EC_TIME_t)(Tick - jitter->LastPoll);
+    uint8_t started = jitter->Started;
+
+    jitter->LastPoll = Tick;
+    jitter->Started = 1;
+    if (!started)
+    {
+        return;
+    }
+
+    jitter->Polls++;
+    EC_histogram_add(&jitter->Hist, gap);
+    if (gap > jitter->MaxGap)
+    {
+        jitter->MaxGap = gap;
+    }
+
+    if (gap > jitter->LateLimit)
+    {
+        jitter->Late++;
+
+        uint8_t index = jitter->StarvedError;
+        if ((EC_JITTER_NO_ERROR != index) && !(Instance->ErrorReg & ((uint64_t)1 << index)))
+        {
+            Instance->ErrorReg |= (uint64_t)1 << index;
+            Instance->WarningReg &= ~((uint64_t)1 << index);
+            Instance->RuntimeData[index].WarningCnt = 0;
+            Instance->RuntimeData[index].WarningPending = 0;
+            EC_EMIT_TRANSITION(Instance, index, EC_TRANSITION_ERROR, Tick);
+        }
+    }
+}
+#endif
+
+#if EC_USE_CHECK_PROFILE
+/**
+ * Adds one sampled ErrFunc duration.
+ */
+static void EC_checkProfileRecord(EC_checkProfile_t *Profile, uint64_t Duration)
+{
+    Profile->Samples++;
+    Profile->Total += Duration;
+    if (Duration > Profile->Max)
+    {
+        Profile->Max = (Duration > UINT32_MAX) ? UINT32_MAX : (uint32_t)Duration;
+    }
+}
+#endif
+
+/**
+ * Clears the selected errors without summary update.
+ */
+static void EC_clearMaskAt(EC_instance_t *Instance, uint64_t Mask)
+{
+    Mask &= EC_ALL_ERRORS_MASK(Instance->NumberOfErrors);
+
+#if EC_TRACK_TRANSITIONS
+    uint64_t cleared = (Instance->ErrorReg | Instance->WarningReg) & Mask;
+#endif
+
+    Instance->ErrorReg &= ~Mask;
+    Instance->WarningReg &= ~Mask;
+
+    EC_TIME_t current_tick = EC_GET_TICK;
+
+    // Only the selected entries are touched - untouched errors keep their debounce progress
+    while (Mask)
+    {
+        uint8_t i = EC_lowestBit(Mask);
+        Mask &= Mask - 1;
+
+        Instance->RuntimeData[i].LastNoErr = current_tick;
+        Instance->RuntimeData[i].WarningCnt = 0;
+        Instance->RuntimeData[i].WarningPending = 0;
+    }
+
+#if EC_TRACK_TRANSITIONS
+    while (cleared)
+    {
+        uint8_t i = EC_lowestBit(cleared);
+        cleared &= cleared - 1;
+
+        EC_EMIT_TRANSITION(Instance, i, EC_TRANSITION_CLEAR, current_tick);
+    }
+#endif
+}
+
 /**
  * Initializes the error control instance.
  */
@@ -54,6 +385,23 @@ void EC_init(EC_instance_t *Instance, const EC_error_t *Errors, EC_runtimeData_t
     Instance->Errors = Errors;
     Instance->NumberOfErrors = NumberOfErrors;
     Instance->RuntimeData = RuntimeDataPtr;
+
+#if EC_USE_SEVERITY
+    for (uint16_t level = 0; level < EC_SEVERITY_LEVELS; level++)
+    {
+        Instance->SeverityAtLeast[level] = 0;
+    }
+    for (uint8_t i = 0; i < NumberOfErrors; i++)
+    {
+        assert(Errors[i].Severity < EC_SEVERITY_LEVELS);
+
+        // Error with severity S belongs to every "at least" mask 0..S
+        for (uint16_t level = 0; level <= Errors[i].Severity; level++)
+        {
+            Instance->SeverityAtLeast[level] |= (uint64_t)1 << i;
+        }
+    }
+#endif
 }
 
 /**
@@ -63,53 +411,226 @@ void EC_poll(EC_instance_t *Instance)
 {
     assert(Instance != NULL);
 
+    EC_PROBE2(poll__entry, Instance, (uint64_t)EC_GET_TICK);
+
+#if EC_USE_WCET
+    uint64_t wcet_start = EC_WCET_NOW();
+    uint64_t wcet_error_reg = Instance->ErrorReg;
+    uint64_t wcet_warning_reg = Instance->WarningReg;
+#endif
+
+#if EC_USE_STATS
+    EC_stats_t *stats = Instance->Stats;
+#endif
+
+#if EC_USE_JITTER
+    if (NULL != Instance->Jitter)
+    {
+        EC_jitterRecord(Instance, EC_GET_TICK);
+    }
+#endif
+
+#if EC_USE_FAULT_INJECTION
+    uint64_t forced = Instance->ForcePresentMask | Instance->ForceAbsentMask;
+    if (forced && (0 != Instance->ForceDuration) &&
+        ((EC_TIME_t)(EC_GET_TICK - Instance->ForceSince) >= Instance->ForceDuration))
+    {
+        EC_fault_clear(Instance);
+        forced = 0;
+    }
+#endif
+
+#if EC_USE_TRACE
+    EC_TIME_t poll_tick = EC_GET_TICK;
+    uint64_t evaluated = 0;
+    uint64_t present = 0;
+#endif
+
+#if EC_USE_SUPPRESSION
+    uint64_t suppressed = 0;
+    uint64_t roots = Instance->ErrorReg & Instance->SuppressorMask;
+    while (roots)
+    {
+        uint8_t root = EC_lowestBit(roots);
+        roots &= roots - 1;
+
+        suppressed |= Instance->SuppressMasks[root] & ~((uint64_t)1 << root);
+    }
+    suppressed &= EC_ALL_ERRORS_MASK(Instance->NumberOfErrors);
+
+    // Suppressed errors keep their state and are only masked when published. Their checks
+    // were skipped, so released errors that are not latched restart debouncing.
+    uint64_t released = Instance->SuppressedReg & ~suppressed & ~Instance->ErrorReg;
+#if EC_USE_STATS
+    uint64_t entered = suppressed & ~Instance->SuppressedReg;
+    while (entered && (NULL != stats))
+    {
+        uint8_t i = EC_lowestBit(entered);
+        entered &= entered - 1;
+
+        if (stats[i].Flags & EC_STATS_PRESENT)
+        {
+            EC_STATS_WRITE_BEGIN(Instance);
+            EC_stats_endPresence(&stats[i], EC_GET_TICK, 0);
+            EC_STATS_WRITE_END(Instance);
+        }
+    }
+#endif
+    Instance->SuppressedReg = suppressed;
+    while (released)
+    {
+        uint8_t i = EC_lowestBit(released);
+        released &= released - 1;
+
+        Instance->RuntimeData[i].LastNoErr = EC_GET_TICK;
+        Instance->RuntimeData[i].WarningPending = 0;
+    }
+#endif
+
     uint64_t error;
     for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
     {
+#if EC_USE_SUPPRESSION
+        if (suppressed & ((uint64_t)1 << i))
+        {
+            continue;
+        }
+#endif
         EC_TIME_t current_tick = EC_GET_TICK;
 
         // Always check error state to update LastNoErr (not blocked by WarningPending)
         if (!(Instance->ErrorReg & ((uint64_t)1 << i)) && (NULL != Instance->Errors[i].ErrFunc))
         {
-            error = (Instance->Errors[i].ErrFunc(Instance->Errors[i].HelperNumber));
+#if EC_USE_FAULT_INJECTION
+            if (forced & ((uint64_t)1 << i))
+            {
+                error = (Instance->ForcePresentMask >> i) & 1u;
+            }
+            else
+#endif
+#if EC_USE_TRACE
+            if (NULL != Instance->PresenceOverride)
+            {
+                error = (*Instance->PresenceOverride >> i) & 1u;
+            }
+            else
+#endif
+            {
+#if EC_USE_CHECK_PROFILE
+                EC_checkProfile_t *profile = (NULL != Instance->CheckProfile) ? &Instance->CheckProfile[i] : NULL;
+
+                // Every call is counted, every EC_CHECK_PROFILE_PERIOD-th call is timed
+                if ((NULL != profile) && (0 == (profile->Calls++ & (EC_CHECK_PROFILE_PERIOD - 1u))))
+                {
+                    uint64_t check_start = EC_WCET_NOW();
+                    error = (Instance->Errors[i].ErrFunc(Instance->Errors[i].HelperNumber));
+                    EC_checkProfileRecord(profile, EC_WCET_NOW() - check_start);
+                }
+                else
+#endif
+                {
+                    error = (Instance->Errors[i].ErrFunc(Instance->Errors[i].HelperNumber));
+                }
+            }
+#if EC_USE_TRACE
+            evaluated |= (uint64_t)1 << i;
+            present |= (uint64_t)(0 != error) << i;
+#endif
             if (0 == error)
             {
+#if EC_USE_STATS
+                if ((NULL != stats) && (stats[i].Flags & EC_STATS_PRESENT))
+                {
+                    // Presence ended - only edges are accounted, not every poll
+                    EC_STATS_WRITE_BEGIN(Instance);
+                    EC_stats_endPresence(&stats[i], current_tick, 1);
+                    EC_STATS_WRITE_END(Instance);
+                }
+#endif
                 Instance->RuntimeData[i].LastNoErr = current_tick;
                 // Clear WarningPending when error disappears (allows fresh detection when it returns)
                 Instance->RuntimeData[i].WarningPending = 0;
             }
             else
             {
+#if EC_USE_STATS
+                if ((NULL != stats) && !(stats[i].Flags & EC_STATS_PRESENT))
+                {
+                    EC_STATS_WRITE_BEGIN(Instance);
+                    stats[i].Flags |= EC_STATS_PRESENT;
+                    stats[i].PresenceSince = current_tick;
+                    stats[i].PresenceCount++;
+#if EC_USE_HISTOGRAMS
+                    if (stats[i].Flags & EC_STATS_ENDED)
+                    {
+                        EC_histogram_add(&stats[i].RecurrenceHist,
+                                         (EC_TIME_t)(current_tick - stats[i].LastPresenceEnd));
+                    }
+#endif
+                    EC_STATS_WRITE_END(Instance);
+                }
+#endif
                 EC_TIME_t no_error_delta = (EC_TIME_t)(current_tick - Instance->RuntimeData[i].LastNoErr);
 
                 if ((0 == Instance->RuntimeData[i].WarningPending) &&
                     (no_error_delta >= Instance->Errors[i].TimeToErrorRegister))
                 {
                     // Error present long enough AND not currently pending
+                    EC_transition_t transition;
                     Instance->RuntimeData[i].WarningCnt++;
                     if (Instance->RuntimeData[i].WarningCnt >= Instance->Errors[i].WarningsToError)
                     {
                         Instance->ErrorReg |= error << i;
                         Instance->WarningReg &= ~((uint64_t)1 << i);
                         Instance->RuntimeData[i].WarningCnt = 0;
+                        transition = EC_TRANSITION_ERROR;
                     }
                     else
                     {
                         Instance->WarningReg |= ((uint64_t)1 << i);
                         Instance->RuntimeData[i].WarningPending = 1;
+                        transition = EC_TRANSITION_WARNING;
                     }
                     Instance->RuntimeData[i].LastReg = current_tick;
+                    EC_EMIT_TRANSITION(Instance, i, transition, current_tick);
                 }
             }
         }
         // Reset warning after timeout
         if ((EC_TIME_t)(current_tick - Instance->RuntimeData[i].LastReg) >= Instance->Errors[i].TimeToResetWarning)
         {
+            // The reset path runs every poll once the timeout elapsed - report only actual state drops
+            uint8_t dropped = (Instance->WarningReg & ((uint64_t)1 << i)) || Instance->RuntimeData[i].WarningCnt;
+
             Instance->WarningReg &= ~((uint64_t)1 << i);
             Instance->RuntimeData[i].WarningCnt = 0;
             Instance->RuntimeData[i].WarningPending = 0;
+            if (dropped)
+            {
+                EC_EMIT_TRANSITION(Instance, i, EC_TRANSITION_RESET, current_tick);
+            }
         }
     }
+
+#if EC_USE_TRACE
+    if (NULL != Instance->OnPresence)
+    {
+        Instance->OnPresence(Instance->PresenceContext, Instance, poll_tick, evaluated, present);
+    }
+#endif
+
+#if EC_USE_HIERARCHY
+    EC_updateSummary(Instance);
+#endif
+
+    EC_PROBE4(poll__exit, Instance, (uint64_t)EC_GET_TICK, Instance->ErrorReg, Instance->WarningReg);
+
+#if EC_USE_WCET
+    if (NULL != Instance->Wcet)
+    {
+        EC_wcetRecord(Instance, EC_WCET_NOW() - wcet_start, wcet_error_reg, wcet_warning_reg);
+    }
+#endif
 }
 
 /**
@@ -119,7 +640,7 @@ uint64_t EC_getErrors(EC_instance_t *Instance)
 {
     assert(Instance != NULL);
 
-    return Instance->ErrorReg;
+    return EC_publishedErrorReg(Instance);
 }
 
 /**
@@ -128,11 +649,11 @@ uint64_t EC_getErrors(EC_instance_t *Instance)
 EC_err_state_t EC_getOneError(EC_instance_t *Instance, uint8_t ErrorNumber)
 {
     assert(Instance != NULL);
-    assert(ErrorNumber <= 64);
+    assert(ErrorNumber < 64);
 
     uint64_t mask = (uint64_t)1 << ErrorNumber;
 
-    return (Instance->ErrorReg & mask) ? EC_ERR : EC_NERR;
+    return (EC_publishedErrorReg(Instance) & mask) ? EC_ERR : EC_NERR;
 }
 
 /**
@@ -141,19 +662,67 @@ EC_err_state_t EC_getOneError(EC_instance_t *Instance, uint8_t ErrorNumber)
 EC_err_state_t EC_checkError(EC_instance_t *Instance, uint8_t ErrorNumber)
 {
     assert(Instance != NULL);
-    assert(ErrorNumber <= 64);
+    assert(ErrorNumber < Instance->NumberOfErrors);
+
+#if EC_USE_SUPPRESSION
+    // Checked first - a latched dependent stays hidden while suppressed
+    if (Instance->SuppressedReg & ((uint64_t)1 << ErrorNumber))
+    {
+        return EC_NERR;
+    }
+#endif
 
-    if (Instance->ErrorReg & (1 << ErrorNumber))
+    if (Instance->ErrorReg & ((uint64_t)1 << ErrorNumber))
     {
         return EC_ERR;
     }
 
     if (NULL != Instance->Errors[ErrorNumber].ErrFunc)
     {
-        EC_err_state_t error = (Instance->Errors[ErrorNumber].ErrFunc(Instance->Errors[ErrorNumber].HelperNumber));
+        EC_err_state_t error;
+#if EC_USE_FAULT_INJECTION
+        if ((Instance->ForcePresentMask | Instance->ForceAbsentMask) & ((uint64_t)1 << ErrorNumber))
+        {
+            error = (EC_err_state_t)((Instance->ForcePresentMask >> ErrorNumber) & 1u);
+        }
+        else
+#endif
+#if EC_USE_TRACE
+        if (NULL != Instance->PresenceOverride)
+        {
+            error = (EC_err_state_t)((*Instance->PresenceOverride >> ErrorNumber) & 1u);
+        }
+        else
+#endif
+        {
+            error = (Instance->Errors[ErrorNumber].ErrFunc(Instance->Errors[ErrorNumber].HelperNumber));
+        }
+        EC_PROBE3(check, Instance, ErrorNumber, (uint8_t)error);
 
         Instance->ErrorReg |= (uint64_t)error << ErrorNumber;
 
+        if (EC_ERR == error)
+        {
+            // Same as escalation in EC_poll() - an error never shows as warning at the same time
+            Instance->WarningReg &= ~((uint64_t)1 << ErrorNumber);
+            Instance->RuntimeData[ErrorNumber].WarningCnt = 0;
+            Instance->RuntimeData[ErrorNumber].WarningPending = 0;
+
+            EC_EMIT_TRANSITION(Instance, ErrorNumber, EC_TRANSITION_ERROR, EC_GET_TICK);
+        }
+
+#if EC_USE_HIERARCHY
+        EC_updateSummary(Instance);
+#endif
+
+#if EC_USE_TRACE
+        if (NULL != Instance->OnEvent)
+        {
+            Instance->OnEvent(Instance->EventContext, Instance, EC_GET_TICK, EC_EVENT_CHECK,
+                              (uint64_t)ErrorNumber | ((uint64_t)error << 8));
+        }
+#endif
+
         return error;
     }
 
@@ -161,17 +730,642 @@ EC_err_state_t EC_checkError(EC_instance_t *Instance, uint8_t ErrorNumber)
 }
 
 /**
- * Clears all error flags in the register.
+ * Clears the selected errors and warnings, restarting their debounce.
  */
-void EC_clearErr(EC_instance_t *Instance)
+void EC_clearMask(EC_instance_t *Instance, uint64_t Mask)
 {
     assert(Instance != NULL);
 
-    for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+    EC_PROBE3(clear__mask, Instance, Mask, (uint64_t)EC_GET_TICK);
+
+    EC_clearMaskAt(Instance, Mask);
+
+#if EC_USE_HIERARCHY
+    EC_updateSummary(Instance);
+#endif
+
+#if EC_USE_TRACE
+    if (NULL != Instance->OnEvent)
     {
-        Instance->RuntimeData[i].LastNoErr = EC_GET_TICK;
-        Instance->RuntimeData[i].WarningPending = 0;
+        Instance->OnEvent(Instance->EventContext, Instance, EC_GET_TICK, EC_EVENT_CLEAR,
+                          Mask & EC_ALL_ERRORS_MASK(Instance->NumberOfErrors));
     }
+#endif
+}
+
+/**
+ * Clears the specified error and its warning state.
+ */
+void EC_clearOneError(EC_instance_t *Instance, uint8_t ErrorNumber)
+{
+    assert(Instance != NULL);
+    assert(ErrorNumber < 64);
 
-    Instance->ErrorReg = 0;
+    EC_clearMask(Instance, (uint64_t)1 << ErrorNumber);
 }
+
+/**
+ * Clears all error flags in the register.
+ */
+void EC_clearErr(EC_instance_t *Instance)
+{
+    EC_clearMask(Instance, UINT64_MAX);
+}
+
+#if EC_USE_SUPPRESSION
+
+/**
+ * Sets the root-cause suppression table.
+ */
+void EC_setSuppression(EC_instance_t *Instance, const uint64_t *SuppressMasks)
+{
+    assert(Instance != NULL);
+
+    uint64_t roots = 0;
+    if (NULL != SuppressMasks)
+    {
+        for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+        {
+            if (SuppressMasks[i] & ~((uint64_t)1 << i))
+            {
+                roots |= (uint64_t)1 << i;
+            }
+        }
+    }
+
+    Instance->SuppressMasks = SuppressMasks;
+    Instance->SuppressorMask = roots;
+}
+
+#endif
+
+#if EC_USE_HIERARCHY
+
+/**
+ * Returns the summary of an instance and all its linked descendants.
+ */
+static uint8_t EC_subtreeSummary(const EC_instance_t *Instance)
+{
+    uint8_t summary = 0;
+
+    if (EC_publishedErrorReg(Instance) || Instance->ChildErrorCnt)
+    {
+        summary |= EC_SUMMARY_ERROR;
+    }
+    if (EC_publishedWarningReg(Instance) || Instance->ChildWarningCnt)
+    {
+        summary |= EC_SUMMARY_WARNING;
+    }
+
+    return summary;
+}
+
+#if EC_USE_SEVERITY
+/**
+ * Returns highest severity + 1 of an instance and all its linked descendants (0 = none).
+ */
+static uint8_t EC_subtreeSeverityLevel(const EC_instance_t *Instance)
+{
+    uint8_t own = EC_getHighestSeverity(Instance);
+    uint8_t result = (EC_SEVERITY_NONE == own) ? 0 : (uint8_t)(own + 1);
+
+    for (uint8_t level = EC_SEVERITY_LEVELS; level > result; level--)
+    {
+        if (Instance->ChildSeverityCnt[level - 1])
+        {
+            return level;
+        }
+    }
+
+    return result;
+}
+#endif
+
+/**
+ * Adds (Sign = 1) or removes (Sign = -1) a child summary from the parent counters.
+ */
+static void EC_applyChildSummary(EC_instance_t *Parent, const EC_instance_t *Child, int8_t Sign)
+{
+    if (Child->Summary & EC_SUMMARY_ERROR)
+    {
+        Parent->ChildErrorCnt = (uint16_t)(Parent->ChildErrorCnt + Sign);
+    }
+    if (Child->Summary & EC_SUMMARY_WARNING)
+    {
+        Parent->ChildWarningCnt = (uint16_t)(Parent->ChildWarningCnt + Sign);
+    }
+#if EC_USE_SEVERITY
+    if (Child->SummaryLevel)
+    {
+        Parent->ChildSeverityCnt[Child->SummaryLevel - 1] =
+            (uint16_t)(Parent->ChildSeverityCnt[Child->SummaryLevel - 1] + Sign);
+    }
+#endif
+}
+
+/**
+ * Recomputes the summary and propagates changes toward the root.
+ */
+void EC_updateSummary(EC_instance_t *Instance)
+{
+    assert(Instance != NULL);
+
+    while (NULL != Instance)
+    {
+        uint8_t summary = EC_subtreeSummary(Instance);
+#if EC_USE_SEVERITY
+        uint8_t level = EC_subtreeSeverityLevel(Instance);
+
+        if ((summary == Instance->Summary) && (level == Instance->SummaryLevel))
+        {
+            return;
+        }
+#else
+        if (summary == Instance->Summary)
+        {
+            return;
+        }
+#endif
+
+        if (NULL != Instance->Parent)
+        {
+            EC_applyChildSummary(Instance->Parent, Instance, -1);
+        }
+        Instance->Summary = summary;
+#if EC_USE_SEVERITY
+        Instance->SummaryLevel = level;
+#endif
+        if (NULL != Instance->Parent)
+        {
+            EC_applyChildSummary(Instance->Parent, Instance, 1);
+        }
+        Instance = Instance->Parent;
+    }
+}
+
+/**
+ * Links a child instance under a parent instance.
+ */
+void EC_link(EC_instance_t *Child, EC_instance_t *Parent)
+{
+    assert(Child != NULL);
+    assert(Parent != NULL);
+    assert(Child->Parent == NULL);
+    assert(Child != Parent);
+
+    Child->Summary = EC_subtreeSummary(Child);
+#if EC_USE_SEVERITY
+    Child->SummaryLevel = EC_subtreeSeverityLevel(Child);
+#endif
+    Child->Parent = Parent;
+    EC_applyChildSummary(Parent, Child, 1);
+    EC_updateSummary(Parent);
+}
+
+/**
+ * Unlinks a child instance from its parent.
+ */
+void EC_unlink(EC_instance_t *Child)
+{
+    assert(Child != NULL);
+
+    EC_instance_t *parent = Child->Parent;
+    if (NULL == parent)
+    {
+        return;
+    }
+
+    EC_applyChildSummary(parent, Child, -1);
+    Child->Parent = NULL;
+    EC_updateSummary(parent);
+}
+
+/**
+ * Returns the subtree summary.
+ */
+uint8_t EC_getSummary(const EC_instance_t *Instance)
+{
+    assert(Instance != NULL);
+
+    return Instance->Summary;
+}
+
+#if EC_USE_SEVERITY
+/**
+ * Returns the highest severity registered in the subtree.
+ */
+uint8_t EC_getSummarySeverity(const EC_instance_t *Instance)
+{
+    assert(Instance != NULL);
+
+    return Instance->SummaryLevel ? (uint8_t)(Instance->SummaryLevel - 1) : EC_SEVERITY_NONE;
+}
+#endif
+
+#endif
+
+#if EC_USE_SEVERITY
+
+/**
+ * Returns the highest severity among registered errors.
+ */
+uint8_t EC_getHighestSeverity(const EC_instance_t *Instance)
+{
+    assert(Instance != NULL);
+
+    uint64_t errors = EC_publishedErrorReg(Instance);
+
+    for (uint8_t level = EC_SEVERITY_LEVELS; level > 0; level--)
+    {
+        if (errors & Instance->SeverityAtLeast[level - 1])
+        {
+            return (uint8_t)(level - 1);
+        }
+    }
+
+    return EC_SEVERITY_NONE;
+}
+
+/**
+ * Returns registered errors with severity at or above the given level.
+ */
+uint64_t EC_getErrorsAtLeast(const EC_instance_t *Instance, uint8_t Severity)
+{
+    assert(Instance != NULL);
+    assert(Severity < EC_SEVERITY_LEVELS);
+
+    return EC_publishedErrorReg(Instance) & Instance->SeverityAtLeast[Severity];
+}
+
+#endif
+
+#if EC_USE_TRANSITION_HOOK
+
+/**
+ * Registers the transition callback of an instance.
+ */
+void EC_transition_callback_register(EC_instance_t *Instance, EC_transition_cb_t Function, void *Context)
+{
+    assert(Instance != NULL);
+
+    Instance->OnTransition = Function;
+    Instance->TransitionContext = Context;
+}
+
+#endif
+
+#if EC_USE_TRACE
+
+/**
+ * Registers the presence callback of an instance.
+ */
+void EC_presence_callback_register(EC_instance_t *Instance, EC_presence_cb_t Function, void *Context)
+{
+    assert(Instance != NULL);
+
+    Instance->OnPresence = Function;
+    Instance->PresenceContext = Context;
+}
+
+/**
+ * Substitutes a presence mask for the ErrFunc calls.
+ */
+void EC_presence_override(EC_instance_t *Instance, const uint64_t *Mask)
+{
+    assert(Instance != NULL);
+
+    Instance->PresenceOverride = Mask;
+}
+
+/**
+ * Registers the event callback of an instance.
+ */
+void EC_event_callback_register(EC_instance_t *Instance, EC_event_cb_t Function, void *Context)
+{
+    assert(Instance != NULL);
+
+    Instance->OnEvent = Function;
+    Instance->EventContext = Context;
+}
+
+#endif
+
+#if EC_USE_STATS
+
+/**
+ * Attaches the statistics array.
+ */
+void EC_stats_register(EC_instance_t *Instance, EC_stats_t *Stats)
+{
+    assert(Instance != NULL);
+
+    Instance->Stats = Stats;
+}
+
+/**
+ * Copies statistics out using the sequence counter instead of a lock.
+ */
+uint8_t EC_stats_read(const EC_instance_t *Instance, EC_stats_t *Out, uint8_t First, uint8_t Count)
+{
+    assert(Instance != NULL);
+    assert(Instance->Stats != NULL);
+    assert(Out != NULL);
+    assert((uint16_t)First + Count <= Instance->NumberOfErrors);
+
+    for (uint8_t attempt = 0; attempt < EC_STATS_READ_RETRIES; attempt++)
+    {
+        uint32_t seq = Instance->StatsSeq;
+        if (seq & 1u)
+        {
+            continue;
+        }
+        EC_MEMORY_BARRIER();
+
+        memcpy(Out, &Instance->Stats[First], (size_t)Count * sizeof(EC_stats_t));
+
+        EC_MEMORY_BARRIER();
+        if (seq == Instance->StatsSeq)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+#endif
+
+#if EC_USE_WCET
+
+/**
+ * Resets the accumulators and attaches them to the instance.
+ */
+void EC_wcet_register(EC_instance_t *Instance, EC_wcet_t *Wcet)
+{
+    assert(Instance != NULL);
+
+    if (NULL != Wcet)
+    {
+        EC_wcet_reset(Wcet);
+    }
+    Instance->Wcet = Wcet;
+}
+
+/**
+ * Resets execution time accumulators.
+ */
+void EC_wcet_reset(EC_wcet_t *Wcet)
+{
+    assert(Wcet != NULL);
+
+    memset(Wcet, 0, sizeof(*Wcet));
+    Wcet->Min = UINT64_MAX;
+}
+
+#endif
+
+#if EC_USE_JITTER
+
+/**
+ * Resets the poll interval monitor and attaches it to the instance.
+ */
+void EC_jitter_register(EC_instance_t *Instance, EC_jitter_t *Jitter, uint8_t LatePercent, uint8_t StarvedError)
+{
+    assert(Instance != NULL);
+    assert((EC_JITTER_NO_ERROR == StarvedError) || (StarvedError < Instance->NumberOfErrors));
+
+    if (NULL != Jitter)
+    {
+        uint64_t fastest = 0;
+
+        for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+        {
+            uint64_t time = (uint64_t)Instance->Errors[i].TimeToErrorRegister;
+
+            if ((NULL != Instance->Errors[i].ErrFunc) && (0 != time) && ((0 == fastest) || (time < fastest)))
+            {
+                fastest = time;
+            }
+        }
+
+        memset(Jitter, 0, sizeof(*Jitter));
+        Jitter->StarvedError = StarvedError;
+        if (0 == fastest)
+        {
+            Jitter->LateLimit = (EC_TIME_t)EC_MAX_TIMEOUT;
+        }
+        else
+        {
+            // Split to avoid overflow of 64-bit ticks, clamp to the EC_TIME_t range
+            uint64_t limit = (fastest / 100u) * LatePercent + (fastest % 100u) * LatePercent / 100u;
+
+            if (limit > (uint64_t)EC_MAX_TIMEOUT)
+            {
+                limit = (uint64_t)EC_MAX_TIMEOUT;
+            }
+            Jitter->LateLimit = (EC_TIME_t)((0 != limit) ? limit : 1u);
+        }
+    }
+
+    Instance->Jitter = Jitter;
+}
+
+#endif
+
+#if EC_USE_FAULT_INJECTION
+
+/**
+ * Sets the forced check results of an instance.
+ */
+void EC_fault_inject(EC_instance_t *Instance, uint64_t ForcePresent, uint64_t ForceAbsent, EC_TIME_t Duration)
+{
+    assert(Instance != NULL);
+    assert(0 == (ForcePresent & ForceAbsent));
+
+    Instance->ForcePresentMask = ForcePresent & EC_ALL_ERRORS_MASK(Instance->NumberOfErrors);
+    Instance->ForceAbsentMask = ForceAbsent & EC_ALL_ERRORS_MASK(Instance->NumberOfErrors);
+    Instance->ForceSince = EC_GET_TICK;
+    Instance->ForceDuration = Duration;
+}
+
+/**
+ * Ends fault injection.
+ */
+void EC_fault_clear(EC_instance_t *Instance)
+{
+    assert(Instance != NULL);
+
+    Instance->ForcePresentMask = 0;
+    Instance->ForceAbsentMask = 0;
+    Instance->ForceDuration = 0;
+}
+
+#endif
+
+#if EC_USE_CHECK_PROFILE
+
+/**
+ * Attaches the check profile array.
+ */
+void EC_check_profile_register(EC_instance_t *Instance, EC_checkProfile_t *Profile)
+{
+    assert(Instance != NULL);
+
+    Instance->CheckProfile = Profile;
+}
+
+/**
+ * Sort key of one profile entry, 0 = not sampled yet.
+ */
+static uint64_t EC_checkProfileKey(const EC_checkProfile_t *Profile, EC_profile_order_t Order)
+{
+    if (0 == Profile->Samples)
+    {
+        return 0;
+    }
+
+    switch (Order)
+    {
+    case EC_PROFILE_BY_MEAN:
+        return Profile->Total / Profile->Samples;
+    case EC_PROFILE_BY_LOAD:
+        return (Profile->Total / Profile->Samples) * Profile->Calls;
+    default:
+        return Profile->Max;
+    }
+}
+
+/**
+ * Lists the slowest checks, slowest first.
+ */
+uint8_t EC_check_profile_top(const EC_instance_t *Instance, EC_profile_order_t Order, uint8_t *Indices,
+                             uint8_t Count)
+{
+    assert(Instance != NULL);
+    assert(Instance->CheckProfile != NULL);
+    assert((Indices != NULL) || (0 == Count));
+
+    uint64_t keys[64];
+    uint8_t found = 0;
+
+    // Insertion into a sorted list of at most Count entries - O(NumberOfErrors * Count)
+    for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+    {
+        const EC_checkProfile_t *profile = &Instance->CheckProfile[i];
+        uint64_t key = EC_checkProfileKey(profile, Order);
+
+        if (0 == profile->Samples)
+        {
+            continue;
+        }
+
+        uint8_t pos = found;
+        while ((pos > 0) && (keys[pos - 1] < key))
+        {
+            pos--;
+        }
+        if (pos >= Count)
+        {
+            continue;
+        }
+
+        uint8_t last = (found < Count) ? found : (uint8_t)(Count - 1);
+        for (uint8_t k = last; k > pos; k--)
+        {
+            keys[k] = keys[k - 1];
+            Indices[k] = Indices[k - 1];
+        }
+        keys[pos] = key;
+        Indices[pos] = i;
+        if (found < Count)
+        {
+            found++;
+        }
+    }
+
+    return found;
+}
+
+#endif
+
+#if EC_HAS_HISTOGRAMS
+
+/**
+ * Adds one duration to its logarithmic bucket.
+ */
+void EC_histogram_add(EC_histogram_t *Histogram, uint64_t Duration)
+{
+    assert(Histogram != NULL);
+
+    uint8_t bucket = 0;
+    if (Duration)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        bucket = (uint8_t)(64 - __builtin_clzll(Duration));
+#else
+        while (Duration)
+        {
+            Duration >>= 1;
+            bucket++;
+        }
+#endif
+        if (bucket >= EC_HISTOGRAM_BUCKETS)
+        {
+            bucket = EC_HISTOGRAM_BUCKETS - 1;
+        }
+    }
+
+    if (Histogram->Bucket[bucket] < UINT32_MAX)
+    {
+        Histogram->Bucket[bucket]++;
+    }
+}
+
+/**
+ * Adds all counts of Source to Destination, saturating.
+ */
+void EC_histogram_merge(EC_histogram_t *Destination, const EC_histogram_t *Source)
+{
+    assert(Destination != NULL);
+    assert(Source != NULL);
+
+    for (uint8_t b = 0; b < EC_HISTOGRAM_BUCKETS; b++)
+    {
+        uint32_t sum = Destination->Bucket[b] + Source->Bucket[b];
+        Destination->Bucket[b] = (sum < Destination->Bucket[b]) ? UINT32_MAX : sum;
+    }
+}
+
+/**
+ * Returns the upper limit of the bucket holding the percentile.
+ */
+uint64_t EC_histogram_percentile(const EC_histogram_t *Histogram, uint8_t Percent)
+{
+    assert(Histogram != NULL);
+    assert(Percent <= 100);
+
+    uint64_t total = 0;
+    for (uint8_t b = 0; b < EC_HISTOGRAM_BUCKETS; b++)
+    {
+        total += Histogram->Bucket[b];
+    }
+    if (0 == total)
+    {
+        return 0;
+    }
+
+    uint64_t rank = (total * Percent + 99) / 100;
+    uint64_t seen = 0;
+    for (uint8_t b = 0; b < EC_HISTOGRAM_BUCKETS - 1; b++)
+    {
+        seen += Histogram->Bucket[b];
+        if ((seen >= rank) && (seen > 0))
+        {
+            return (b == 0) ? 0 : (((uint64_t)1 << b) - 1);
+        }
+    }
+
+    return UINT64_MAX;
+}
+
+#endif
@@ -86,7 +86,298 @@
  *
  * @note Default: 0 (variable-based)
  */
+#ifndef EC_TICK_FROM_FUNC
 #define EC_TICK_FROM_FUNC 0
+#endif
+
+/**
+ * @def EC_USE_SUPPRESSION
+ * @brief Enables root-cause suppression of dependent errors
+ *
+ * When set to 1, an error can be declared as the root cause of a group of
+ * dependent errors (see EC_setSuppression()). While the root error is
+ * registered, its dependents are masked from the published registers and
+ * their check functions are not called.
+ *
+ * @note Default: 0 (disabled, no RAM or CPU overhead)
+ */
+#ifndef EC_USE_SUPPRESSION
+#define EC_USE_SUPPRESSION 0
+#endif
+
+/**
+ * @def EC_USE_HIERARCHY
+ * @brief Enables parent/child instance aggregation
+ *
+ * When set to 1, instances can be linked into a tree (subsystem -> board ->
+ * system, see EC_link()). Each instance keeps a summary of its own registers
+ * and of its whole subtree, updated incrementally only when registers change,
+ * so the health of the top-level instance is read in O(1).
+ *
+ * @note Default: 0 (disabled, no RAM or CPU overhead)
+ */
+#ifndef EC_USE_HIERARCHY
+#define EC_USE_HIERARCHY 0
+#endif
+
+/**
+ * @def EC_USE_SEVERITY
+ * @brief Enables per-error severity classes
+ *
+ * When set to 1, EC_error_t gets a Severity field and the instance keeps one
+ * precomputed mask per severity level. The highest active severity and the
+ * set of errors at or above a severity are then answered with a few word
+ * operations (see EC_getHighestSeverity(), EC_getErrorsAtLeast()).
+ *
+ * With EC_USE_HIERARCHY also enabled, the highest severity of each subtree is
+ * propagated to the parent together with the summary flags.
+ *
+ * @note Default: 0 (disabled, no RAM or CPU overhead)
+ */
+#ifndef EC_USE_SEVERITY
+#define EC_USE_SEVERITY 0
+#endif
+
+/**
+ * @def EC_USE_TRANSITION_HOOK
+ * @brief Enables the per-instance transition callback
+ *
+ * When set to 1, every state transition (warning registered, error
+ * registered, warning reset, error/warning cleared) is reported to a
+ * user-registered callback (see EC_transition_callback_register()). The
+ * callback is only invoked at transitions, never for quiescent errors.
+ *
+ * The transition stream is the input of the notification, logging and
+ * history modules.
+ *
+ * @note Default: 0 (disabled, no RAM or CPU overhead)
+ */
+#ifndef EC_USE_TRANSITION_HOOK
+#define EC_USE_TRANSITION_HOOK 0
+#endif
+
+/**
+ * @def EC_USE_STATS
+ * @brief Enables incremental per-error statistics
+ *
+ * When set to 1, an optional array of EC_stats_t (one per error, see
+ * EC_stats_register()) is maintained by the library: warning/error counts,
+ * total time in warning and in error, and the longest continuous presence.
+ * Counters are updated only at transition points and presence edges, never
+ * for quiescent errors, and live outside EC_runtimeData_t so the hot runtime
+ * structure stays small.
+ *
+ * @note Default: 0 (disabled, no RAM or CPU overhead)
+ */
+#ifndef EC_USE_STATS
+#define EC_USE_STATS 0
+#endif
+
+/**
+ * @def EC_STATS_READ_RETRIES
+ * @brief Attempts made by EC_stats_read() before giving up
+ *
+ * @note Default: 8
+ */
+#ifndef EC_STATS_READ_RETRIES
+#define EC_STATS_READ_RETRIES 8
+#endif
+
+/**
+ * @def EC_USE_HISTOGRAMS
+ * @brief Adds duration histograms to EC_stats_t
+ *
+ * When set to 1 (requires EC_USE_STATS), every EC_stats_t carries two
+ * logarithmic-bucket histograms updated O(1) at presence edges:
+ * - PresenceHist: how long the condition stays present before clearing
+ *   or latching (see EC_stats_t for the exact period boundaries)
+ * - RecurrenceHist: how long the condition stays absent before it returns
+ *
+ * These are the distributions TimeToErrorRegister and TimeToResetWarning
+ * are tuned from. Histograms of different instances or nodes are combined
+ * with EC_histogram_merge().
+ *
+ * @note Default: 0 (disabled)
+ */
+#ifndef EC_USE_HISTOGRAMS
+#define EC_USE_HISTOGRAMS 0
+#endif
+
+/**
+ * @def EC_HISTOGRAM_BUCKETS
+ * @brief Number of histogram buckets (2-65)
+ *
+ * Bucket 0 counts zero durations, bucket B counts durations in
+ * [2^(B-1), 2^B - 1]; the last bucket also takes everything longer.
+ * Each bucket costs 4 bytes per histogram.
+ *
+ * @note Default: 24 (last bucket starts at 2^22 ticks, ~70 min @ 1kHz)
+ */
+#ifndef EC_HISTOGRAM_BUCKETS
+#define EC_HISTOGRAM_BUCKETS 24
+#endif
+
+#if EC_USE_HISTOGRAMS && !EC_USE_STATS
+#error "EC_USE_HISTOGRAMS requires EC_USE_STATS = 1"
+#endif
+
+/**
+ * @def EC_USE_TRACE
+ * @brief Enables presence tracing and replay hooks
+ *
+ * When set to 1, each instance can carry:
+ * - a presence callback, called at the end of every EC_poll() with the
+ *   tick and the ErrFunc results of that poll (see EC_presence_callback_register())
+ * - a presence override mask that EC_poll() and EC_checkError() read instead
+ *   of calling ErrFunc (see EC_presence_override())
+ * - an event callback for the inputs outside EC_poll() that change the state:
+ *   clears and evaluating EC_checkError() calls (see EC_event_callback_register())
+ *
+ * Used by err_core_trace to record field behaviour and replay it offline.
+ *
+ * @note Default: 0 (disabled, no RAM or CPU overhead)
+ */
+#ifndef EC_USE_TRACE
+#define EC_USE_TRACE 0
+#endif
+
+/**
+ * @def EC_USE_WCET
+ * @brief Enables execution time capture of EC_poll()
+ *
+ * When set to 1, an optional EC_wcet_t (see EC_wcet_register()) collects
+ * the duration of every EC_poll() call: minimum, maximum, total, a
+ * logarithmic histogram and the input conditions of the slowest call.
+ * Costs two counter reads and a few compares per poll.
+ *
+ * @note Default: 0 (disabled, no RAM or CPU overhead)
+ */
+#ifndef EC_USE_WCET
+#define EC_USE_WCET 0
+#endif
+
+/**
+ * @def EC_USE_CHECK_PROFILE
+ * @brief Enables sampled execution time profiling of ErrFunc calls
+ *
+ * When set to 1, an optional array of EC_checkProfile_t (one per error, see
+ * EC_check_profile_register()) counts every ErrFunc call made by EC_poll()
+ * and times every EC_CHECK_PROFILE_PERIOD-th call of each error: mean and
+ * maximum duration. EC_check_profile_top() lists the slowest checks.
+ *
+ * @note Default: 0 (disabled, no RAM or CPU overhead)
+ */
+#ifndef EC_USE_CHECK_PROFILE
+#define EC_USE_CHECK_PROFILE 0
+#endif
+
+/**
+ * @def EC_CHECK_PROFILE_PERIOD
+ * @brief Sampling period of EC_USE_CHECK_PROFILE (power of two)
+ *
+ * 1 times every call. Larger values bound the overhead to two counter reads
+ * per EC_CHECK_PROFILE_PERIOD calls of each check.
+ *
+ * @note Default: 16
+ */
+#ifndef EC_CHECK_PROFILE_PERIOD
+#define EC_CHECK_PROFILE_PERIOD 16u
+#endif
+
+#if EC_USE_CHECK_PROFILE && (EC_CHECK_PROFILE_PERIOD & (EC_CHECK_PROFILE_PERIOD - 1))
+#error "EC_CHECK_PROFILE_PERIOD must be a power of two"
+#endif
+
+/**
+ * @def EC_USE_JITTER
+ * @brief Enables the poll interval monitor
+ *
+ * When set to 1, an optional EC_jitter_t (see EC_jitter_register()) tracks
+ * the ticks between consecutive EC_poll() calls of an instance: histogram,
+ * largest gap and the number of late polls - gaps longer than a configured
+ * percentage of the smallest TimeToErrorRegister, which delay registration.
+ * A late poll can also register a reserved "poller starved" error.
+ *
+ * @note Default: 0 (disabled, no RAM or CPU overhead)
+ */
+#ifndef EC_USE_JITTER
+#define EC_USE_JITTER 0
+#endif
+
+/**
+ * @def EC_USE_FAULT_INJECTION
+ * @brief Enables runtime fault injection
+ *
+ * When set to 1, each instance carries force-present and force-absent masks
+ * (see EC_fault_inject()) applied on top of the check results in EC_poll()
+ * and EC_checkError(), with an optional expiry. Forced errors skip their
+ * ErrFunc and run through the normal debounce, escalation and reset logic,
+ * so recovery paths can be tested on production builds.
+ *
+ * @note Default: 0 (disabled, no RAM or CPU overhead)
+ */
+#ifndef EC_USE_FAULT_INJECTION
+#define EC_USE_FAULT_INJECTION 0
+#endif
+
+/**
+ * @def EC_USE_USDT
+ * @brief Enables USDT static tracepoints (Linux, requires sys/sdt.h)
+ *
+ * When set to 1 on Linux, err_core.c places probes of provider "err_core"
+ * for bpftrace, perf and SystemTap:
+ *
+ * | Probe       | Arguments                                  |
+ * |-------------|--------------------------------------------|
+ * | poll__entry | instance, tick                             |
+ * | poll__exit  | instance, tick, ErrorReg, WarningReg       |
+ * | warning     | instance, error, tick, WarningCnt          |
+ * | error       | instance, error, tick, WarningCnt          |
+ * | reset       | instance, error, tick, WarningCnt          |
+ * | clear       | instance, error, tick, WarningCnt          |
+ * | check       | instance, error, result (ErrFunc called)   |
+ * | clear__mask | instance, mask, tick                       |
+ *
+ * An unattached probe is a single nop. On other targets the option
+ * compiles to nothing.
+ *
+ * @note Default: 0 (disabled, no RAM or CPU overhead)
+ */
+#ifndef EC_USE_USDT
+#define EC_USE_USDT 0
+#endif
+
+/**
+ * @def EC_WCET_NOW
+ * @brief Counter read used by EC_USE_WCET and EC_USE_CHECK_PROFILE, returns uint64_t
+ *
+ * Built-in defaults:
+ * - x86: TSC (rdtsc)
+ * - AArch64: virtual counter (cntvct_el0)
+ * - other Linux/POSIX: clock_gettime(CLOCK_MONOTONIC) in nanoseconds
+ *
+ * Define it for any other target, e.g. the Cortex-M cycle counter:
+ * @code
+ * #define EC_WCET_NOW() ((uint64_t)DWT->CYCCNT)
+ * @endcode
+ * All EC_wcet_t and EC_checkProfile_t durations are in units of this counter.
+ */
+
+/** @brief Histogram support is compiled in for any feature that uses it */
+#define EC_HAS_HISTOGRAMS (EC_USE_HISTOGRAMS || EC_USE_WCET || EC_USE_JITTER)
+
+/**
+ * @def EC_SEVERITY_LEVELS
+ * @brief Number of severity levels (1-255) when EC_USE_SEVERITY is 1
+ *
+ * Levels are numbered 0 (lowest) to EC_SEVERITY_LEVELS - 1 (highest).
+ * Each level costs 8 bytes of RAM per instance.
+ *
+ * @note Default: 8
+ */
+#ifndef EC_SEVERITY_LEVELS
+#define EC_SEVERITY_LEVELS 8
+#endif
 
 /*******************************************************************************
  * TIME BASE CONFIGURATION
@@ -171,6 +462,100 @@ typedef enum
     EC_ERR = 1   /**< Error detected - condition is abnormal */
 } EC_err_state_t;
 
+/**
+ * @enum EC_transition_t
+ * @brief Error state transition kinds
+ *
+ * Reported through the transition callback when EC_USE_TRANSITION_HOOK is 1.
+ */
+typedef enum
+{
+    EC_TRANSITION_WARNING = 0, /**< Warning registered - WarningReg bit set, WarningCnt incremented */
+    EC_TRANSITION_ERROR = 1,   /**< Error registered - by escalation or EC_checkError() */
+    EC_TRANSITION_RESET = 2,   /**< Warning state dropped after TimeToResetWarning */
+    EC_TRANSITION_CLEAR = 3    /**< Error/warning cleared by EC_clearMask() or suppression */
+} EC_transition_t;
+
+struct EC_instance_s;
+
+/**
+ * @brief Transition callback type
+ *
+ * @param Context     User pointer given at registration
+ * @param Instance    Instance in which the transition occurred
+ * @param ErrorNumber Index of the error (0-63)
+ * @param Transition  Kind of transition
+ * @param Tick        Tick at which the transition occurred
+ *
+ * @note Called from EC_poll(), EC_checkError() and the clear functions,
+ *       after registers and runtime data have been updated
+ * @note Must not call EC_poll() or clear functions of the same instance
+ */
+typedef void (*EC_transition_cb_t)(void *Context, const struct EC_instance_s *Instance, uint8_t ErrorNumber,
+                                   EC_transition_t Transition, EC_TIME_t Tick);
+
+#if EC_USE_TRACE
+
+/**
+ * @brief Presence callback type
+ *
+ * @param Context   User pointer given at registration
+ * @param Instance  Polled instance
+ * @param Tick      Tick at the start of the poll
+ * @param Evaluated Errors whose ErrFunc was evaluated in this poll
+ *                  (not registered, not suppressed, ErrFunc set)
+ * @param Present   ErrFunc results of the evaluated errors (other bits 0)
+ *
+ * @note Called once at the end of every EC_poll()
+ */
+typedef void (*EC_presence_cb_t)(void *Context, const struct EC_instance_s *Instance, EC_TIME_t Tick,
+                                 uint64_t Evaluated, uint64_t Present);
+
+/**
+ * @enum EC_event_t
+ * @brief State-changing calls outside EC_poll(), reported to the event callback
+ */
+typedef enum
+{
+    EC_EVENT_CLEAR = 0, /**< EC_clearMask(), EC_clearOneError(), EC_clearErr() - Arg: cleared mask */
+    EC_EVENT_CHECK = 1  /**< EC_checkError() that evaluated the error - Arg: index | result << 8 */
+} EC_event_t;
+
+/**
+ * @brief Event callback type
+ *
+ * @param Context  User pointer given at registration
+ * @param Instance Affected instance
+ * @param Tick     Tick of the call
+ * @param Event    Kind of call
+ * @param Arg      Event argument (see EC_event_t)
+ *
+ * @note Called after registers and runtime data have been updated. Checks of
+ *       errors that are registered, suppressed or have no ErrFunc are not
+ *       reported - they do not depend on any input.
+ */
+typedef void (*EC_event_cb_t)(void *Context, const struct EC_instance_s *Instance, EC_TIME_t Tick, EC_event_t Event,
+                              uint64_t Arg);
+
+#endif
+
+#if EC_USE_HIERARCHY
+
+/** @brief Summary flag - at least one error registered in the subtree */
+#define EC_SUMMARY_ERROR 0x01u
+
+/** @brief Summary flag - at least one warning active in the subtree */
+#define EC_SUMMARY_WARNING 0x02u
+
+#endif
+
+#if EC_USE_SEVERITY
+
+/** @brief Returned by severity queries when no error is registered */
+#define EC_SEVERITY_NONE 0xFFu
+
+#endif
+
 /**
  * @struct EC_runtimeData_t
  * @brief Runtime data for error tracking
@@ -205,6 +590,156 @@ typedef struct
                                      Cleared after TimeToResetWarning elapses */
 } EC_runtimeData_t;
 
+#if EC_HAS_HISTOGRAMS
+
+/**
+ * @struct EC_histogram_t
+ * @brief Logarithmic-bucket histogram of durations (ticks, or counter units for EC_USE_WCET)
+ */
+typedef struct
+{
+    uint32_t Bucket[EC_HISTOGRAM_BUCKETS]; /**< Saturating counters, see EC_HISTOGRAM_BUCKETS */
+} EC_histogram_t;
+
+#endif
+
+#if EC_USE_STATS
+
+/** @brief EC_stats_t flag - condition present at last evaluation */
+#define EC_STATS_PRESENT 0x01u
+
+/** @brief EC_stats_t flag - warning period open */
+#define EC_STATS_IN_WARNING 0x02u
+
+/** @brief EC_stats_t flag - error period open */
+#define EC_STATS_IN_ERROR 0x04u
+
+/** @brief EC_stats_t flag - a presence has ended before (LastPresenceEnd valid) */
+#define EC_STATS_ENDED 0x08u
+
+/**
+ * @struct EC_stats_t
+ * @brief Incremental statistics of one error
+ *
+ * Maintained by the library when EC_USE_STATS is 1 and an array is
+ * registered with EC_stats_register(). Array must be in RAM and initialized
+ * to zero.
+ *
+ * Totals include closed periods only; a period still open is described by
+ * the *Since field and the corresponding flag.
+ *
+ * A presence period measures how long the check reported the condition
+ * while it was running. It ends when the check returns EC_NERR, when the
+ * error latches in ErrorReg (the check is no longer called) or when the
+ * error becomes suppressed. Latched and suppressed time is therefore not
+ * part of MaxPresence or PresenceHist; a condition still present after a
+ * clear or a release starts a new period. RecurrenceHist only takes
+ * absences the check observed, i.e. it skips the period after a latch or
+ * suppression.
+ */
+typedef struct
+{
+    uint32_t WarningCount;   /**< Number of warnings registered */
+    uint32_t ErrorCount;     /**< Number of errors registered */
+    uint32_t PresenceCount;  /**< Number of times the condition became present */
+    uint64_t TimeInWarning;  /**< Total ticks with WarningReg bit set (closed periods) */
+    uint64_t TimeInError;    /**< Total ticks with ErrorReg bit set (closed periods) */
+    EC_TIME_t MaxPresence;   /**< Longest continuous presence of the condition in ticks (checked time only) */
+    EC_TIME_t PresenceSince; /**< Tick the current presence started (valid with EC_STATS_PRESENT) */
+    EC_TIME_t WarningSince;  /**< Tick the current warning period started (valid with EC_STATS_IN_WARNING) */
+    EC_TIME_t ErrorSince;    /**< Tick the current error period started (valid with EC_STATS_IN_ERROR) */
+    uint8_t Flags;           /**< Combination of EC_STATS_* flags */
+#if EC_USE_HISTOGRAMS
+    EC_TIME_t LastPresenceEnd;     /**< Tick the last presence ended (valid with EC_STATS_ENDED) */
+    EC_histogram_t PresenceHist;   /**< Distribution of presence durations */
+    EC_histogram_t RecurrenceHist; /**< Distribution of absence durations between presences */
+#endif
+} EC_stats_t;
+
+#endif
+
+#if EC_USE_WCET
+
+/**
+ * @struct EC_wcet_t
+ * @brief EC_poll() execution time accumulators
+ *
+ * Durations are in EC_WCET_NOW() units and include the transition,
+ * presence and hierarchy updates done inside the poll.
+ */
+typedef struct
+{
+    uint64_t Calls;      /**< Measured EC_poll() calls */
+    uint64_t Min;        /**< Shortest call (UINT64_MAX before the first call) */
+    uint64_t Max;        /**< Longest call */
+    uint64_t Total;      /**< Sum of all calls (mean = Total / Calls) */
+    EC_histogram_t Hist; /**< Distribution of call durations */
+
+    /** @name Conditions of the longest call */
+    /** @{ */
+    uint64_t WorstCall;          /**< Calls value of the longest call (1 = first) */
+    EC_TIME_t WorstTick;         /**< Tick of the call */
+    uint64_t WorstErrorReg;      /**< ErrorReg at entry (set errors skip ErrFunc) */
+    uint64_t WorstWarningReg;    /**< WarningReg at entry */
+    uint64_t WorstErrorRegOut;   /**< ErrorReg at exit */
+    uint64_t WorstWarningRegOut; /**< WarningReg at exit */
+    /** @} */
+} EC_wcet_t;
+
+#endif
+
+#if EC_USE_JITTER
+
+/** @brief EC_jitter_register() StarvedError value - no starved error */
+#define EC_JITTER_NO_ERROR 0xFFu
+
+/**
+ * @struct EC_jitter_t
+ * @brief Poll interval monitor of one instance
+ */
+typedef struct
+{
+    EC_histogram_t Hist;  /**< Distribution of poll intervals in ticks */
+    uint32_t Polls;       /**< Measured intervals */
+    uint32_t Late;        /**< Intervals longer than LateLimit */
+    EC_TIME_t MaxGap;     /**< Longest interval */
+    EC_TIME_t LastPoll;   /**< Tick of the previous poll */
+    EC_TIME_t LateLimit;  /**< Late threshold in ticks, set by EC_jitter_register() */
+    uint8_t StarvedError; /**< Error registered on a late poll (EC_JITTER_NO_ERROR = none) */
+    uint8_t Started;      /**< LastPoll is valid */
+} EC_jitter_t;
+
+#endif
+
+#if EC_USE_CHECK_PROFILE
+
+/**
+ * @struct EC_checkProfile_t
+ * @brief Sampled ErrFunc execution time of one error
+ *
+ * Durations are in EC_WCET_NOW() units.
+ */
+typedef struct
+{
+    uint64_t Total;   /**< Sum of the sampled durations (mean = Total / Samples) */
+    uint32_t Max;     /**< Longest sampled duration (saturating) */
+    uint32_t Calls;   /**< ErrFunc calls by EC_poll() (wrapping) */
+    uint32_t Samples; /**< Timed calls */
+} EC_checkProfile_t;
+
+/**
+ * @enum EC_profile_order_t
+ * @brief Sort key of EC_check_profile_top()
+ */
+typedef enum
+{
+    EC_PROFILE_BY_MAX = 0,  /**< Longest sampled call */
+    EC_PROFILE_BY_MEAN = 1, /**< Mean sampled call */
+    EC_PROFILE_BY_LOAD = 2  /**< Estimated total time: mean x Calls */
+} EC_profile_order_t;
+
+#endif
+
 /**
  * @struct EC_error_t
  * @brief Error definition structure
@@ -309,6 +844,16 @@ typedef struct
      */
     uint16_t WarningsToError;
 
+#if EC_USE_SEVERITY
+    /**
+     * @brief Severity class of the error (0 = lowest)
+     *
+     * Must be lower than EC_SEVERITY_LEVELS. Errors declared without an
+     * explicit severity default to the lowest level.
+     */
+    uint8_t Severity;
+#endif
+
 } EC_error_t;
 
 /**
@@ -337,7 +882,7 @@ typedef struct
  * }
  * @endcode
  */
-typedef struct
+typedef struct EC_instance_s
 {
     /**
      * @brief Error register - 64-bit bitfield of registered errors
@@ -353,7 +898,8 @@ typedef struct
      * - 1: Error registered (action required)
      *
      * @note Updated automatically by EC_poll()
-     * @note Can be cleared with EC_clearErr()
+     * @note Can be cleared with EC_clearErr(), EC_clearMask() or EC_clearOneError()
+     * @note Includes suppressed errors - read it through EC_getErrors() or EC_publishedErrorReg()
      */
     uint64_t ErrorReg;
 
@@ -396,42 +942,353 @@ typedef struct
      */
     uint8_t NumberOfErrors;
 
-} EC_instance_t;
-
-/*******************************************************************************
- * FUNCTION PROTOTYPES
- ******************************************************************************/
-
-#if EC_TICK_FROM_FUNC
+#if EC_USE_SUPPRESSION
+    /**
+     * @brief Pointer to suppression table (NULL = no suppression)
+     *
+     * Entry N is the mask of errors suppressed while error N is registered.
+     * Set with EC_setSuppression().
+     */
+    const uint64_t *SuppressMasks;
 
-/**
- * @brief Registers system tick source function
- *
- * Call this once during initialization when EC_TICK_FROM_FUNC is 1.
- * The registered function will be called by EC_poll() to get current time.
- *
- * @param[in] Function Pointer to function returning current tick count
- *
- * @pre Function must not be NULL
- * @post All subsequent EC_poll() calls will use this function for timing
- *
- * @note Function should execute in < 10µs
- * @note Function must be reentrant if EC_poll() can be called from interrupts
- *
- * @example FreeRTOS tick function
- * @code
- * EC_TIME_t get_system_tick(void) {
- *     return (EC_TIME_t)xTaskGetTickCount();
- * }
- *
- * void init(void) {
- *     EC_tick_function_register(get_system_tick);
- * }
- * @endcode
- */
-void EC_tick_function_register(EC_TIME_t (*Function)(void));
+    /**
+     * @brief Bitfield of errors having a non-zero suppression mask
+     *
+     * Computed by EC_setSuppression() so EC_poll() only visits actual roots.
+     */
+    uint64_t SuppressorMask;
 
-#else
+    /**
+     * @brief Suppressed register - errors currently masked by a registered root
+     *
+     * Bit Value:
+     * - 0: Error evaluated normally
+     * - 1: Error suppressed (check not called, masked from the published registers)
+     *
+     * @note Updated automatically by EC_poll()
+     */
+    uint64_t SuppressedReg;
+#endif
+
+#if EC_USE_SEVERITY
+    /**
+     * @brief Cumulative severity masks
+     *
+     * Entry S has a bit set for every error whose Severity is >= S.
+     * Computed by EC_init() from the Errors table.
+     */
+    uint64_t SeverityAtLeast[EC_SEVERITY_LEVELS];
+#endif
+
+#if EC_USE_TRANSITION_HOOK
+    /**
+     * @brief Transition callback (NULL = none)
+     *
+     * Set with EC_transition_callback_register().
+     */
+    EC_transition_cb_t OnTransition;
+
+    /**
+     * @brief User pointer passed to OnTransition
+     */
+    void *TransitionContext;
+#endif
+
+#if EC_USE_STATS
+    /**
+     * @brief Pointer to statistics array (NULL = statistics off)
+     *
+     * Set with EC_stats_register().
+     */
+    EC_stats_t *Stats;
+
+    /**
+     * @brief Statistics sequence counter
+     *
+     * Odd while the library updates statistics, incremented again when done.
+     * Lets EC_stats_read() copy consistent data without a lock.
+     */
+    volatile uint32_t StatsSeq;
+#endif
+
+#if EC_USE_TRACE
+    /**
+     * @brief Presence callback (NULL = none)
+     *
+     * Set with EC_presence_callback_register().
+     */
+    EC_presence_cb_t OnPresence;
+
+    /**
+     * @brief User pointer passed to OnPresence
+     */
+    void *PresenceContext;
+
+    /**
+     * @brief Presence mask used instead of ErrFunc (NULL = call ErrFunc)
+     *
+     * Set with EC_presence_override().
+     */
+    const uint64_t *PresenceOverride;
+
+    /**
+     * @brief Event callback (NULL = none)
+     *
+     * Set with EC_event_callback_register().
+     */
+    EC_event_cb_t OnEvent;
+
+    /**
+     * @brief User pointer passed to OnEvent
+     */
+    void *EventContext;
+#endif
+
+#if EC_USE_WCET
+    /**
+     * @brief Pointer to execution time accumulators (NULL = capture off)
+     *
+     * Set with EC_wcet_register().
+     */
+    EC_wcet_t *Wcet;
+#endif
+
+#if EC_USE_JITTER
+    /**
+     * @brief Pointer to poll interval monitor (NULL = monitor off)
+     *
+     * Set with EC_jitter_register().
+     */
+    EC_jitter_t *Jitter;
+#endif
+
+#if EC_USE_CHECK_PROFILE
+    /**
+     * @brief Pointer to per-error check profile array (NULL = profiling off)
+     *
+     * Set with EC_check_profile_register().
+     */
+    EC_checkProfile_t *CheckProfile;
+#endif
+
+#if EC_USE_FAULT_INJECTION
+    /**
+     * @brief Errors reported present regardless of ErrFunc
+     *
+     * Set with EC_fault_inject(). Disjoint with ForceAbsentMask.
+     */
+    uint64_t ForcePresentMask;
+
+    /**
+     * @brief Errors reported absent regardless of ErrFunc
+     *
+     * Set with EC_fault_inject(). Disjoint with ForcePresentMask.
+     */
+    uint64_t ForceAbsentMask;
+
+    /**
+     * @brief Tick of the EC_fault_inject() call
+     */
+    EC_TIME_t ForceSince;
+
+    /**
+     * @brief Injection lifetime in ticks (0 = until EC_fault_clear())
+     */
+    EC_TIME_t ForceDuration;
+#endif
+
+#if EC_USE_HIERARCHY
+    /**
+     * @brief Parent instance in the aggregation tree (NULL = top level)
+     *
+     * Set with EC_link(), cleared with EC_unlink().
+     */
+    struct EC_instance_s *Parent;
+
+    /**
+     * @brief Number of direct children whose subtree has a registered error
+     */
+    uint16_t ChildErrorCnt;
+
+    /**
+     * @brief Number of direct children whose subtree has an active warning
+     */
+    uint16_t ChildWarningCnt;
+
+    /**
+     * @brief Subtree summary - combination of EC_SUMMARY_* flags
+     *
+     * Covers this instance's own registers and all linked descendants.
+     *
+     * @note Updated automatically by EC_poll(), EC_checkError() and the clear functions
+     * @note Read with EC_getSummary()
+     */
+    uint8_t Summary;
+
+#if EC_USE_SEVERITY
+    /**
+     * @brief Number of direct children per subtree highest severity
+     */
+    uint16_t ChildSeverityCnt[EC_SEVERITY_LEVELS];
+
+    /**
+     * @brief Highest severity registered in the subtree plus one (0 = none)
+     *
+     * Offset by one so a zero-initialized instance reports no severity.
+     *
+     * @note Read with EC_getSummarySeverity()
+     */
+    uint8_t SummaryLevel;
+#endif
+#endif
+
+} EC_instance_t;
+
+/*******************************************************************************
+ * HELPERS
+ ******************************************************************************/
+
+/** @brief Mask with one bit set for every error of an instance with n errors (n = 1..64) */
+#define EC_ALL_ERRORS_MASK(n) (((n) >= 64) ? UINT64_MAX : (((uint64_t)1 << (n)) - 1))
+
+/**
+ * @brief Returns the index of the lowest set bit
+ *
+ * Used to visit only the set bits of a register:
+ * @code
+ * while (mask) {
+ *     uint8_t i = EC_lowestBit(mask);
+ *     mask &= mask - 1;
+ *     // ... handle error i
+ * }
+ * @endcode
+ *
+ * @param[in] Mask Bitfield, must not be zero
+ * @return Index of the lowest set bit (0-63)
+ */
+static inline uint8_t EC_lowestBit(uint64_t Mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)__builtin_ctzll(Mask);
+#else
+    uint8_t i = 0;
+    while (!(Mask & 1u))
+    {
+        Mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/**
+ * @brief Returns ErrorReg as published by EC_getErrors()
+ *
+ * ErrorReg and WarningReg hold the internal state. Errors suppressed by a
+ * registered root (EC_USE_SUPPRESSION) keep their bits there, but are masked
+ * out of every published view: getters, summaries, severity queries and
+ * exporters.
+ *
+ * @param[in] Instance Pointer to error instance
+ * @return ErrorReg without suppressed errors
+ */
+static inline uint64_t EC_publishedErrorReg(const EC_instance_t *Instance)
+{
+#if EC_USE_SUPPRESSION
+    return Instance->ErrorReg & ~Instance->SuppressedReg;
+#else
+    return Instance->ErrorReg;
+#endif
+}
+
+/**
+ * @brief Returns WarningReg without suppressed errors (see EC_publishedErrorReg())
+ *
+ * @param[in] Instance Pointer to error instance
+ * @return WarningReg without suppressed errors
+ */
+static inline uint64_t EC_publishedWarningReg(const EC_instance_t *Instance)
+{
+#if EC_USE_SUPPRESSION
+    return Instance->WarningReg & ~Instance->SuppressedReg;
+#else
+    return Instance->WarningReg;
+#endif
+}
+
+/**
+ * @brief Applies a transition to a pair of shadow registers
+ *
+ * Mirrors the register effect of each EC_transition_t so consumers of the
+ * transition stream (loggers, decoders, history) can track ErrorReg and
+ * WarningReg without access to the instance.
+ *
+ * @param[in,out] ErrorReg    Shadow error register
+ * @param[in,out] WarningReg  Shadow warning register
+ * @param[in]     ErrorNumber Index of the error (0-63)
+ * @param[in]     Transition  Kind of transition
+ */
+static inline void EC_transition_apply(uint64_t *ErrorReg, uint64_t *WarningReg, uint8_t ErrorNumber,
+                                       EC_transition_t Transition)
+{
+    uint64_t bit = (uint64_t)1 << ErrorNumber;
+
+    switch (Transition)
+    {
+    case EC_TRANSITION_WARNING:
+        *WarningReg |= bit;
+        break;
+    case EC_TRANSITION_ERROR:
+        *ErrorReg |= bit;
+        *WarningReg &= ~bit;
+        break;
+    case EC_TRANSITION_RESET:
+        *WarningReg &= ~bit;
+        break;
+    default:
+        *ErrorReg &= ~bit;
+        *WarningReg &= ~bit;
+        break;
+    }
+}
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if EC_TICK_FROM_FUNC
+
+/**
+ * @brief Registers system tick source function
+ *
+ * Call this once during initialization when EC_TICK_FROM_FUNC is 1.
+ * The registered function will be called by EC_poll() to get current time.
+ *
+ * @param[in] Function Pointer to function returning current tick count
+ *
+ * @pre Function must not be NULL
+ * @post All subsequent EC_poll() calls will use this function for timing
+ *
+ * @note Function should execute in < 10µs
+ * @note Function must be reentrant if EC_poll() can be called from interrupts
+ *
+ * @example FreeRTOS tick function
+ * @code
+ * EC_TIME_t get_system_tick(void) {
+ *     return (EC_TIME_t)xTaskGetTickCount();
+ * }
+ *
+ * void init(void) {
+ *     EC_tick_function_register(get_system_tick);
+ * }
+ * @endcode
+ */
+void EC_tick_function_register(EC_TIME_t (*Function)(void));
+
+/** @brief Registered tick function (NULL until EC_tick_function_register() is called) */
+extern EC_TIME_t (*EC_get_tick)(void);
+
+#else
 
 /**
  * @brief Registers system tick source variable
@@ -463,6 +1320,9 @@ void EC_tick_function_register(EC_TIME_t (*Function)(void));
  */
 void EC_tick_variable_register(EC_TIME_t *Variable);
 
+/** @brief Registered tick variable (NULL until EC_tick_variable_register() is called) */
+extern EC_TIME_t *EC_tick;
+
 #endif
 
 /**
@@ -616,18 +1476,22 @@ EC_err_state_t EC_getOneError(EC_instance_t *Instance, uint8_t ErrorNumber);
  * need immediate attention.
  *
  * @param[in,out] Instance    Pointer to error instance
- * @param[in]     ErrorNumber Index of error to force-check (0-63)
+ * @param[in]     ErrorNumber Index of error to force-check (0 to NumberOfErrors - 1)
  *
  * @return Current error state after check
  * @retval EC_NERR Error condition not present
  * @retval EC_ERR  Error condition present and now registered
  *
  * @pre Instance must be initialized
- * @pre ErrorNumber must be 0-63
+ * @pre ErrorNumber must be below NumberOfErrors (asserted)
  * @pre Error check function must not be NULL
  *
  * @post If error present, ErrorReg bit is set immediately
- * @post WarningReg and warning counters are NOT updated
+ * @post If error present, its WarningReg bit, WarningCnt and WarningPending
+ *       are cleared - as on escalation in EC_poll()
+ *
+ * @note Up to 2.0.1 the warning state of the registered error was left
+ *       untouched, so the error could show in ErrorReg and WarningReg at once
  *
  * @warning Bypasses all timing and warning logic
  * @warning Use sparingly for truly critical errors only
@@ -670,6 +1534,7 @@ EC_err_state_t EC_checkError(EC_instance_t *Instance, uint8_t ErrorNumber);
  *
  * @note Does NOT clear error definitions or configuration
  * @note Errors will be re-detected on next EC_poll() if conditions persist
+ * @note Equivalent to EC_clearMask(Instance, UINT64_MAX)
  *
  * @example Error acknowledgment
  * @code
@@ -687,4 +1552,525 @@ EC_err_state_t EC_checkError(EC_instance_t *Instance, uint8_t ErrorNumber);
  */
 void EC_clearErr(EC_instance_t *Instance);
 
+/**
+ * @brief Clears selected errors and warnings
+ *
+ * Acknowledges only the errors selected by Mask. Every selected error is
+ * returned to its initial state:
+ * - ErrorReg and WarningReg bits cleared
+ * - WarningCnt and WarningPending reset
+ * - LastNoErr set to current tick (debounce restarts)
+ *
+ * Errors outside Mask are not touched and keep their debounce progress.
+ * Only the set bits of Mask are visited, so acknowledging a single error
+ * costs the same regardless of NumberOfErrors.
+ *
+ * @param[in,out] Instance Pointer to error instance
+ * @param[in]     Mask     Bitfield of errors to clear (bit N = error N)
+ *
+ * @pre Instance must be initialized
+ *
+ * @post (ErrorReg & Mask) == 0
+ * @post (WarningReg & Mask) == 0
+ *
+ * @note Bits above NumberOfErrors are ignored
+ *
+ * @example Acknowledge a group of errors
+ * @code
+ * #define COMM_ERRORS ((1ULL << ERR_CAN_TIMEOUT) | (1ULL << ERR_UART_TIMEOUT))
+ *
+ * void comm_reconnected(void) {
+ *     EC_clearMask(&instance, COMM_ERRORS);
+ * }
+ * @endcode
+ */
+void EC_clearMask(EC_instance_t *Instance, uint64_t Mask);
+
+/**
+ * @brief Clears a single error and its warning state
+ *
+ * Shorthand for EC_clearMask() with one bit set.
+ *
+ * @param[in,out] Instance    Pointer to error instance
+ * @param[in]     ErrorNumber Index of error to clear (0-63)
+ *
+ * @pre Instance must be initialized
+ * @pre ErrorNumber must be 0-63
+ *
+ * @example Acknowledge one fault
+ * @code
+ * void on_user_ack(uint8_t error_number) {
+ *     EC_clearOneError(&instance, error_number);
+ * }
+ * @endcode
+ */
+void EC_clearOneError(EC_instance_t *Instance, uint8_t ErrorNumber);
+
+#if EC_USE_SUPPRESSION
+
+/**
+ * @brief Declares root-cause dependencies between errors
+ *
+ * Entry N of SuppressMasks lists the errors that depend on error N. While
+ * error N is registered in ErrorReg, every error in SuppressMasks[N]:
+ * - is masked from the published registers (EC_getErrors(), EC_getOneError(),
+ *   summaries, severity queries, exporters - see EC_publishedErrorReg())
+ * - is not evaluated by EC_poll() (its ErrFunc is not called)
+ * - is reported as EC_NERR by EC_checkError()
+ *
+ * The dependent keeps its state: a dependent latched before the root fired
+ * is published again when the root clears, and no transition is emitted for
+ * entering or leaving suppression. Dependents that are not latched restart
+ * debouncing when the root clears.
+ *
+ * Suppression is recomputed at the start of every EC_poll() from the set
+ * bits of ErrorReg, so the cost is proportional to the number of registered
+ * roots, not to NumberOfErrors.
+ *
+ * @param[in,out] Instance      Pointer to error instance
+ * @param[in]     SuppressMasks Pointer to array of NumberOfErrors masks,
+ *                              or NULL to disable suppression
+ *
+ * @pre Instance must be initialized
+ * @pre SuppressMasks must remain valid for lifetime of instance
+ *
+ * @note Dependencies are not followed transitively - if A suppresses B and B
+ *       suppresses C, list C in A's mask as well
+ * @note Dependencies must not form cycles
+ * @note A root error never suppresses itself
+ *
+ * @example CAN bus loss suppresses sensor timeouts
+ * @code
+ * const uint64_t suppress[NUM_ERRORS] = {
+ *     [ERR_CAN_BUS_OFF] = (1ULL << ERR_SENSOR1_TIMEOUT) | (1ULL << ERR_SENSOR2_TIMEOUT),
+ * };
+ *
+ * EC_init(&instance, errors, runtime, NUM_ERRORS);
+ * EC_setSuppression(&instance, suppress);
+ * @endcode
+ */
+void EC_setSuppression(EC_instance_t *Instance, const uint64_t *SuppressMasks);
+
+#endif
+
+#if EC_USE_HIERARCHY
+
+/**
+ * @brief Links an instance under a parent instance
+ *
+ * The child's subtree summary is added to the parent and propagated upward.
+ * From then on, every change of the child's summary is propagated to the
+ * parent automatically; unchanged children cost nothing.
+ *
+ * A parent does not need its own errors - a zero-initialized instance that
+ * is never passed to EC_init() or EC_poll() works as a pure aggregation node.
+ *
+ * @param[in,out] Child  Instance to link (must not already have a parent)
+ * @param[in,out] Parent Instance to link under
+ *
+ * @pre Child must not be linked
+ * @pre Linking must not create a cycle
+ *
+ * @note Instances of one tree must be polled from the same context
+ *
+ * @example Subsystem -> board -> system
+ * @code
+ * EC_instance_t system = {0};
+ * EC_instance_t board = {0};
+ *
+ * EC_link(&board, &system);
+ * EC_link(&sensor_errors, &board);
+ * EC_link(&comm_errors, &board);
+ *
+ * while(1) {
+ *     EC_poll(&sensor_errors);
+ *     EC_poll(&comm_errors);
+ *
+ *     if (EC_getSummary(&system) & EC_SUMMARY_ERROR) {
+ *         enter_safe_state();
+ *     }
+ * }
+ * @endcode
+ */
+void EC_link(EC_instance_t *Child, EC_instance_t *Parent);
+
+/**
+ * @brief Removes an instance from its parent
+ *
+ * The child's contribution is removed from all ancestors.
+ *
+ * @param[in,out] Child Instance to unlink (no effect if it has no parent)
+ */
+void EC_unlink(EC_instance_t *Child);
+
+/**
+ * @brief Returns the subtree summary of an instance
+ *
+ * @param[in] Instance Pointer to error instance
+ * @return Combination of EC_SUMMARY_ERROR and EC_SUMMARY_WARNING, 0 if healthy
+ *
+ * @note Execution time: O(1) regardless of tree size
+ */
+uint8_t EC_getSummary(const EC_instance_t *Instance);
+
+/**
+ * @brief Recomputes the summary of an instance and propagates it upward
+ *
+ * Called automatically by the library. Call it manually only after
+ * modifying ErrorReg or WarningReg directly.
+ *
+ * @param[in,out] Instance Pointer to error instance
+ *
+ * @note Walks up only while summaries change - O(depth) worst case
+ */
+void EC_updateSummary(EC_instance_t *Instance);
+
+#if EC_USE_SEVERITY
+
+/**
+ * @brief Returns the highest severity registered in the subtree
+ *
+ * @param[in] Instance Pointer to error instance
+ * @return Highest severity of all registered errors in this instance and its
+ *         linked descendants, or EC_SEVERITY_NONE if none are registered
+ *
+ * @note Execution time: O(1) regardless of tree size
+ */
+uint8_t EC_getSummarySeverity(const EC_instance_t *Instance);
+
+#endif
+
+#endif
+
+#if EC_USE_TRANSITION_HOOK
+
+/**
+ * @brief Registers the transition callback of an instance
+ *
+ * The callback receives every warning, error, reset and clear transition of
+ * the instance. Only one callback per instance is supported; consumers that
+ * need the stream (notifier, logger, history) provide callbacks matching
+ * EC_transition_cb_t.
+ *
+ * @param[in,out] Instance Pointer to error instance
+ * @param[in]     Function Callback, or NULL to disable
+ * @param[in]     Context  User pointer passed to every call
+ *
+ * @example Printing transitions
+ * @code
+ * void on_transition(void *ctx, const EC_instance_t *inst, uint8_t idx,
+ *                    EC_transition_t tr, EC_TIME_t tick) {
+ *     printf("[%lu] error %u: %d\n", (unsigned long)tick, idx, tr);
+ * }
+ *
+ * EC_transition_callback_register(&instance, on_transition, NULL);
+ * @endcode
+ */
+void EC_transition_callback_register(EC_instance_t *Instance, EC_transition_cb_t Function, void *Context);
+
+#endif
+
+#if EC_USE_TRACE
+
+/**
+ * @brief Registers the presence callback of an instance
+ *
+ * @param[in,out] Instance Pointer to error instance
+ * @param[in]     Function Callback, or NULL to disable
+ * @param[in]     Context  User pointer passed to every call
+ */
+void EC_presence_callback_register(EC_instance_t *Instance, EC_presence_cb_t Function, void *Context);
+
+/**
+ * @brief Substitutes a presence mask for the ErrFunc calls of an instance
+ *
+ * While set, EC_poll() and EC_checkError() take the presence of error i from
+ * bit i of *Mask instead of calling ErrFunc. Errors without ErrFunc stay
+ * unevaluated.
+ *
+ * @param[in,out] Instance Pointer to error instance
+ * @param[in]     Mask     Presence mask read on every poll, or NULL to call ErrFunc again
+ */
+void EC_presence_override(EC_instance_t *Instance, const uint64_t *Mask);
+
+/**
+ * @brief Registers the event callback of an instance
+ *
+ * @param[in,out] Instance Pointer to error instance
+ * @param[in]     Function Callback, or NULL to disable
+ * @param[in]     Context  User pointer passed to every call
+ */
+void EC_event_callback_register(EC_instance_t *Instance, EC_event_cb_t Function, void *Context);
+
+#endif
+
+#if EC_USE_STATS
+
+/**
+ * @brief Attaches a statistics array to an instance
+ *
+ * @param[in,out] Instance Pointer to initialized instance
+ * @param[in]     Stats    Array of NumberOfErrors entries (zero-initialized),
+ *                         or NULL to stop collecting
+ *
+ * @example Fleet metrics
+ * @code
+ * EC_stats_t stats[NUM_ERRORS] = {0};
+ * EC_stats_register(&instance, stats);
+ * @endcode
+ */
+void EC_stats_register(EC_instance_t *Instance, EC_stats_t *Stats);
+
+/**
+ * @brief Copies statistics out without locking
+ *
+ * Uses the instance sequence counter: the copy is retried when EC_poll(),
+ * EC_checkError() or a clear function updated statistics meanwhile. Safe to
+ * call from a different context than EC_poll().
+ *
+ * The counter is odd only for the few stores of one update (a presence edge
+ * or a transition), never around ErrFunc or user callbacks, so a reader
+ * rarely has to retry. Each copied entry is consistent; entries of one copy
+ * may come from different points within the same EC_poll(). A reader that
+ * preempts the writer inside an update window (single core) gets 0 and
+ * should try again later instead of spinning.
+ *
+ * @param[in]  Instance Pointer to instance with registered statistics
+ * @param[out] Out      Destination array of Count entries
+ * @param[in]  First    Index of first error to copy
+ * @param[in]  Count    Number of entries to copy
+ *
+ * @return 1 if a consistent copy was made, 0 if the writer kept interfering
+ *         for EC_STATS_READ_RETRIES attempts
+ *
+ * @example Periodic upload
+ * @code
+ * EC_stats_t copy[NUM_ERRORS];
+ * if (EC_stats_read(&instance, copy, 0, NUM_ERRORS)) {
+ *     upload_metrics(copy, NUM_ERRORS);
+ * }
+ * @endcode
+ */
+uint8_t EC_stats_read(const EC_instance_t *Instance, EC_stats_t *Out, uint8_t First, uint8_t Count);
+
+#endif
+
+#if EC_HAS_HISTOGRAMS
+
+/**
+ * @brief Adds one duration to a histogram
+ *
+ * @param[in,out] Histogram Target histogram
+ * @param[in]     Duration  Duration (ticks or counter units)
+ *
+ * @note Execution time: O(1)
+ */
+void EC_histogram_add(EC_histogram_t *Histogram, uint64_t Duration);
+
+/**
+ * @brief Adds all counts of Source to Destination
+ *
+ * Used to combine histograms of the same error across instances, nodes or
+ * reporting periods. Counters saturate instead of wrapping.
+ *
+ * @param[in,out] Destination Accumulating histogram
+ * @param[in]     Source      Histogram to add
+ */
+void EC_histogram_merge(EC_histogram_t *Destination, const EC_histogram_t *Source);
+
+/**
+ * @brief Returns an upper bound of the given percentile
+ *
+ * @param[in] Histogram Histogram to query
+ * @param[in] Percent   Percentile (0-100)
+ *
+ * @return Upper limit of the bucket holding the percentile in ticks
+ *         (UINT64_MAX for the open last bucket), 0 for an empty histogram
+ *
+ * @example Debounce tuning
+ * @code
+ * // Glitches shorter than the 99th percentile of presences that cleared by themselves
+ * EC_TIME_t suggested = (EC_TIME_t)EC_histogram_percentile(&stats[i].PresenceHist, 99);
+ * @endcode
+ */
+uint64_t EC_histogram_percentile(const EC_histogram_t *Histogram, uint8_t Percent);
+
+#endif
+
+#if EC_USE_WCET
+
+/**
+ * @brief Attaches execution time accumulators to an instance
+ *
+ * Resets Wcet and starts measuring every following EC_poll() call.
+ *
+ * @param[in,out] Instance Pointer to error instance
+ * @param[out]    Wcet     Accumulators, or NULL to stop measuring
+ *
+ * @example Poll time budget check
+ * @code
+ * EC_wcet_t wcet;
+ * EC_wcet_register(&instance, &wcet);
+ * ...
+ * if (wcet.Max > POLL_BUDGET_CYCLES) {
+ *     log_worst(wcet.WorstTick, wcet.WorstErrorReg, wcet.WorstErrorRegOut);
+ * }
+ * @endcode
+ */
+void EC_wcet_register(EC_instance_t *Instance, EC_wcet_t *Wcet);
+
+/**
+ * @brief Resets execution time accumulators
+ *
+ * @param[out] Wcet Accumulators to reset
+ */
+void EC_wcet_reset(EC_wcet_t *Wcet);
+
+#endif
+
+#if EC_USE_JITTER
+
+/**
+ * @brief Attaches a poll interval monitor to an instance
+ *
+ * LateLimit is LatePercent percent of the smallest non-zero
+ * TimeToErrorRegister among errors with ErrFunc (at least 1 tick); without
+ * such an error no poll counts as late. Call after EC_init(); the first
+ * following poll only sets the reference tick.
+ *
+ * @param[in,out] Instance     Pointer to initialized instance
+ * @param[out]    Jitter       Monitor to reset and attach, or NULL to stop monitoring
+ * @param[in]     LatePercent  Late threshold in percent of the smallest TimeToErrorRegister
+ * @param[in]     StarvedError Index of a reserved error (ErrFunc NULL) registered on
+ *                             every late poll, or EC_JITTER_NO_ERROR
+ *
+ * @example Flag polls later than a quarter of the fastest debounce
+ * @code
+ * const EC_error_t errors[] = {
+ *     ...
+ *     {NULL, 0, 0, 0, 1},   // ERR_POLL_STARVED, registered by the monitor
+ * };
+ * EC_jitter_t jitter;
+ * EC_jitter_register(&instance, &jitter, 25, ERR_POLL_STARVED);
+ * @endcode
+ */
+void EC_jitter_register(EC_instance_t *Instance, EC_jitter_t *Jitter, uint8_t LatePercent, uint8_t StarvedError);
+
+#endif
+
+#if EC_USE_FAULT_INJECTION
+
+/**
+ * @brief Forces check results of an instance
+ *
+ * Replaces the masks of a previous injection. Errors in ForcePresent are
+ * evaluated as present and errors in ForceAbsent as absent without calling
+ * their ErrFunc; debouncing, escalation and warning reset work as for real
+ * check results. Errors without ErrFunc are never evaluated and stay
+ * unaffected.
+ *
+ * When Duration elapses, the first following EC_poll() drops both masks
+ * and checks run normally again. Errors registered by the injection stay
+ * registered until cleared.
+ *
+ * @param[in,out] Instance     Pointer to initialized instance
+ * @param[in]     ForcePresent Errors to report present
+ * @param[in]     ForceAbsent  Errors to report absent (disjoint with ForcePresent)
+ * @param[in]     Duration     Lifetime in ticks from now, 0 = until EC_fault_clear()
+ *
+ * @example Overcurrent for 500 ms, then check the recovery
+ * @code
+ * EC_fault_inject(&instance, (uint64_t)1 << ERR_OVERCURRENT, 0, 500);
+ * @endcode
+ */
+void EC_fault_inject(EC_instance_t *Instance, uint64_t ForcePresent, uint64_t ForceAbsent, EC_TIME_t Duration);
+
+/**
+ * @brief Ends fault injection, checks call ErrFunc again
+ *
+ * Registered errors and warnings are not cleared.
+ *
+ * @param[in,out] Instance Pointer to initialized instance
+ */
+void EC_fault_clear(EC_instance_t *Instance);
+
+#endif
+
+#if EC_USE_CHECK_PROFILE
+
+/**
+ * @brief Attaches a per-error check profile array to an instance
+ *
+ * @param[in,out] Instance Pointer to error instance
+ * @param[in]     Profile  Zero-initialized array of NumberOfErrors entries,
+ *                         or NULL to stop profiling
+ */
+void EC_check_profile_register(EC_instance_t *Instance, EC_checkProfile_t *Profile);
+
+/**
+ * @brief Lists the slowest checks of an instance
+ *
+ * Errors without timed calls are not listed.
+ *
+ * @param[in]  Instance Pointer to instance with registered profile
+ * @param[in]  Order    Sort key
+ * @param[out] Indices  Error indices, slowest first
+ * @param[in]  Count    Capacity of Indices
+ *
+ * @return Number of indices written
+ *
+ * @example Report the five slowest checks
+ * @code
+ * uint8_t slow[5];
+ * uint8_t n = EC_check_profile_top(&instance, EC_PROFILE_BY_MAX, slow, 5);
+ * for (uint8_t k = 0; k < n; k++) {
+ *     const EC_checkProfile_t *p = &profile[slow[k]];
+ *     printf("check %u: max %lu mean %llu\n", slow[k], p->Max, p->Total / p->Samples);
+ * }
+ * @endcode
+ */
+uint8_t EC_check_profile_top(const EC_instance_t *Instance, EC_profile_order_t Order, uint8_t *Indices,
+                             uint8_t Count);
+
+#endif
+
+#if EC_USE_SEVERITY
+
+/**
+ * @brief Returns the highest severity among registered errors
+ *
+ * @param[in] Instance Pointer to error instance
+ * @return Highest Severity of any error set in ErrorReg,
+ *         or EC_SEVERITY_NONE if no error is registered
+ *
+ * @pre Instance must be initialized
+ *
+ * @note Execution time: at most EC_SEVERITY_LEVELS mask tests, independent of NumberOfErrors
+ *
+ * @example Safety state selection
+ * @code
+ * switch (EC_getHighestSeverity(&instance)) {
+ *     case SEV_FATAL:    enter_safe_stop();  break;
+ *     case SEV_DEGRADED: limit_power();      break;
+ *     default:           break;
+ * }
+ * @endcode
+ */
+uint8_t EC_getHighestSeverity(const EC_instance_t *Instance);
+
+/**
+ * @brief Returns registered errors with severity at or above a level
+ *
+ * @param[in] Instance Pointer to error instance
+ * @param[in] Severity Minimum severity (0 to EC_SEVERITY_LEVELS - 1)
+ * @return Subset of ErrorReg whose Severity >= Severity
+ *
+ * @pre Instance must be initialized
+ *
+ * @note Execution time: one AND operation
+ */
+uint64_t EC_getErrorsAtLeast(const EC_instance_t *Instance, uint8_t Severity);
+
+#endif
+
 #endif /* ERR_CORE_ERR_CORE_H_ */
\ No newline at end of file
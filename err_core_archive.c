@@ -0,0 +1,420 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#include "err_core_archive.h"
+#include "assert.h"
+
+/**
+ * Encodes Value as LEB128 varint, returns number of bytes written (1-10).
+ */
+static size_t EC_archive_putVarint(uint8_t *Out, uint64_t Value)
+{
+    size_t len = 0;
+
+    while (Value >= 0x80u)
+    {
+        Out[len++] = (uint8_t)(Value | 0x80u);
+        Value >>= 7;
+    }
+    Out[len++] = (uint8_t)Value;
+
+    return len;
+}
+
+/**
+ * Decodes a LEB128 varint, returns 0 if it runs past End.
+ */
+static uint8_t EC_archive_getVarint(const uint8_t **Pos, const uint8_t *End, uint64_t *Value)
+{
+    uint64_t value = 0;
+
+    for (uint8_t shift = 0; (shift < 70) && (*Pos < End); shift += 7)
+    {
+        uint8_t byte = *(*Pos)++;
+        value |= (uint64_t)(byte & 0x7Fu) << shift;
+
+        if (!(byte & 0x80u))
+        {
+            *Value = value;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void EC_archive_put(uint8_t *Out, uint64_t Value, uint8_t Size)
+{
+    for (uint8_t i = 0; i < Size; i++)
+    {
+        Out[i] = (uint8_t)(Value >> (8u * i));
+    }
+}
+
+static uint64_t EC_archive_get(const uint8_t *In, uint8_t Size)
+{
+    uint64_t value = 0;
+
+    for (uint8_t i = 0; i < Size; i++)
+    {
+        value |= (uint64_t)In[i] << (8u * i);
+    }
+
+    return value;
+}
+
+/**
+ * FNV-1a over a byte buffer.
+ */
+static uint32_t EC_archive_checksum(const uint8_t *Data, size_t Size)
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < Size; i++)
+    {
+        hash ^= Data[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * Run-length encodes the XOR chain of one register column.
+ */
+static size_t EC_archive_encodeColumn(uint8_t *Out, const EC_archiveSample_t *Samples, uint16_t Count,
+                                      size_t Field)
+{
+    size_t len = 0;
+    uint64_t previous = 0;
+    uint64_t zeros = 0;
+
+    for (uint16_t i = 0; i < Count; i++)
+    {
+        uint64_t value = *(const uint64_t *)((const uint8_t *)&Samples[i] + Field);
+        uint64_t change = value ^ previous;
+        previous = value;
+
+        if (0 == change)
+        {
+            zeros++;
+            continue;
+        }
+        len += EC_archive_putVarint(&Out[len], zeros);
+        len += EC_archive_putVarint(&Out[len], change);
+        zeros = 0;
+    }
+
+    if (zeros)
+    {
+        len += EC_archive_putVarint(&Out[len], zeros);
+    }
+
+    return len;
+}
+
+/**
+ * Initializes an archive writer.
+ */
+void EC_archive_init(EC_archiveWriter_t *Writer, EC_archiveSample_t *Samples, uint16_t Capacity, uint8_t *Chunk,
+                     size_t ChunkSize, void (*Sink)(void *Context, const uint8_t *Data, size_t Size),
+                     void *Context)
+{
+    assert(Writer != NULL);
+    assert(Samples != NULL);
+    assert(Capacity > 0);
+    assert(Chunk != NULL);
+    assert(ChunkSize >= EC_ARCHIVE_CHUNK_MAX(Capacity));
+    assert(Sink != NULL);
+
+    Writer->Samples = Samples;
+    Writer->Capacity = Capacity;
+    Writer->Count = 0;
+    Writer->Chunk = Chunk;
+    Writer->ChunkSize = ChunkSize;
+    Writer->Sink = Sink;
+    Writer->Context = Context;
+}
+
+/**
+ * Stages one sample.
+ */
+void EC_archive_append(EC_archiveWriter_t *Writer, uint64_t Tick, uint64_t ErrorReg, uint64_t WarningReg)
+{
+    assert(Writer != NULL);
+    assert((0 == Writer->Count) || (Tick >= Writer->Samples[Writer->Count - 1u].Tick));
+
+    EC_archiveSample_t *sample = &Writer->Samples[Writer->Count++];
+    sample->Tick = Tick;
+    sample->ErrorReg = ErrorReg;
+    sample->WarningReg = WarningReg;
+
+    if (Writer->Count == Writer->Capacity)
+    {
+        EC_archive_flush(Writer);
+    }
+}
+
+/**
+ * Encodes the staged samples column by column and emits the chunk.
+ */
+void EC_archive_flush(EC_archiveWriter_t *Writer)
+{
+    assert(Writer != NULL);
+
+    if (0 == Writer->Count)
+    {
+        return;
+    }
+
+    const EC_archiveSample_t *samples = Writer->Samples;
+    uint16_t count = Writer->Count;
+    uint8_t *chunk = Writer->Chunk;
+    uint8_t *columns = &chunk[EC_ARCHIVE_HEADER_SIZE];
+    uint64_t ever_error = 0;
+    uint64_t ever_warning = 0;
+
+    size_t tick_len = 0;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (i > 0)
+        {
+            tick_len += EC_archive_putVarint(&columns[tick_len], samples[i].Tick - samples[i - 1u].Tick);
+        }
+        ever_error |= samples[i].ErrorReg;
+        ever_warning |= samples[i].WarningReg;
+    }
+
+    size_t error_len =
+        EC_archive_encodeColumn(&columns[tick_len], samples, count, offsetof(EC_archiveSample_t, ErrorReg));
+    size_t warning_len = EC_archive_encodeColumn(&columns[tick_len + error_len], samples, count,
+                                                 offsetof(EC_archiveSample_t, WarningReg));
+    size_t columns_len = tick_len + error_len + warning_len;
+
+    chunk[0] = 'E';
+    chunk[1] = 'C';
+    chunk[2] = 'A';
+    chunk[3] = EC_ARCHIVE_VERSION;
+    EC_archive_put(&chunk[4], count, 2);
+    EC_archive_put(&chunk[6], 0, 2);
+    EC_archive_put(&chunk[8], samples[0].Tick, 8);
+    EC_archive_put(&chunk[16], samples[count - 1u].Tick, 8);
+    EC_archive_put(&chunk[24], ever_error, 8);
+    EC_archive_put(&chunk[32], ever_warning, 8);
+    EC_archive_put(&chunk[40], tick_len, 4);
+    EC_archive_put(&chunk[44], error_len, 4);
+    EC_archive_put(&chunk[48], warning_len, 4);
+    EC_archive_put(&chunk[52], EC_archive_checksum(columns, columns_len), 4);
+
+    Writer->Sink(Writer->Context, chunk, EC_ARCHIVE_HEADER_SIZE + columns_len);
+    Writer->Count = 0;
+}
+
+/**
+ * Validates a chunk and reads its header.
+ */
+uint8_t EC_archive_chunk_info(const uint8_t *Data, size_t Size, EC_archiveChunkInfo_t *Info)
+{
+    assert(Data != NULL);
+    assert(Info != NULL);
+
+    if ((Size < EC_ARCHIVE_HEADER_SIZE) || ('E' != Data[0]) || ('C' != Data[1]) || ('A' != Data[2]) ||
+        (EC_ARCHIVE_VERSION != Data[3]))
+    {
+        return 0;
+    }
+
+    size_t columns_len = (size_t)EC_archive_get(&Data[40], 4) + (size_t)EC_archive_get(&Data[44], 4) +
+                         (size_t)EC_archive_get(&Data[48], 4);
+
+    Info->Count = (uint16_t)EC_archive_get(&Data[4], 2);
+    Info->FirstTick = EC_archive_get(&Data[8], 8);
+    Info->LastTick = EC_archive_get(&Data[16], 8);
+    Info->EverError = EC_archive_get(&Data[24], 8);
+    Info->EverWarning = EC_archive_get(&Data[32], 8);
+    Info->Size = EC_ARCHIVE_HEADER_SIZE + columns_len;
+
+    return (0 != Info->Count) && (Info->Size <= Size) &&
+           (EC_archive_get(&Data[52], 4) == EC_archive_checksum(&Data[EC_ARCHIVE_HEADER_SIZE], columns_len));
+}
+
+/**
+ * Cursor over one run-length encoded register column.
+ */
+typedef struct
+{
+    const uint8_t *Pos;
+    const uint8_t *End;
+    uint64_t Value;
+    uint64_t Zeros;
+} EC_archiveColumn_t;
+
+/**
+ * Advances a register column by one sample, returns 0 on malformed data.
+ * Zeros holds the unchanged samples still to emit before the next XOR word.
+ */
+static uint8_t EC_archive_nextValue(EC_archiveColumn_t *Column)
+{
+    if (Column->Zeros)
+    {
+        Column->Zeros--;
+        return 1;
+    }
+
+    uint64_t change;
+    if (!EC_archive_getVarint(&Column->Pos, Column->End, &change))
+    {
+        return 0;
+    }
+    Column->Value ^= change;
+
+    // Every XOR word is followed by the zero-run before the next one (absent at the end)
+    if ((Column->Pos < Column->End) && !EC_archive_getVarint(&Column->Pos, Column->End, &Column->Zeros))
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * Decodes all samples of a validated chunk, reporting those within [From, To].
+ */
+static int32_t EC_archive_decode(const uint8_t *Data, const EC_archiveChunkInfo_t *Info, uint64_t From, uint64_t To,
+                                 void (*OnSample)(void *Context, const EC_archiveSample_t *Sample), void *Context)
+{
+    const uint8_t *ticks = &Data[EC_ARCHIVE_HEADER_SIZE];
+    const uint8_t *ticks_end = ticks + EC_archive_get(&Data[40], 4);
+    EC_archiveColumn_t error = {ticks_end, ticks_end + EC_archive_get(&Data[44], 4), 0, 0};
+    EC_archiveColumn_t warning = {error.End, error.End + EC_archive_get(&Data[48], 4), 0, 0};
+    EC_archiveSample_t sample = {Info->FirstTick, 0, 0};
+    int32_t reported = 0;
+
+    // Columns are (zero-run, XOR word) pairs - load the leading runs
+    if (!EC_archive_getVarint(&error.Pos, error.End, &error.Zeros) ||
+        !EC_archive_getVarint(&warning.Pos, warning.End, &warning.Zeros))
+    {
+        return -1;
+    }
+
+    for (uint16_t i = 0; i < Info->Count; i++)
+    {
+        uint64_t delta;
+
+        if ((i > 0) && !EC_archive_getVarint(&ticks, ticks_end, &delta))
+        {
+            return -1;
+        }
+        if (i > 0)
+        {
+            sample.Tick += delta;
+        }
+        if (!EC_archive_nextValue(&error) || !EC_archive_nextValue(&warning))
+        {
+            return -1;
+        }
+        if (sample.Tick > To)
+        {
+            break;
+        }
+        if (sample.Tick >= From)
+        {
+            sample.ErrorReg = error.Value;
+            sample.WarningReg = warning.Value;
+            OnSample(Context, &sample);
+            reported++;
+        }
+    }
+
+    return reported;
+}
+
+/**
+ * Reports every sample of a chunk within [From, To].
+ */
+int32_t EC_archive_scan(const uint8_t *Data, size_t Size, uint64_t From, uint64_t To,
+                        void (*OnSample)(void *Context, const EC_archiveSample_t *Sample), void *Context)
+{
+    assert(Data != NULL);
+    assert(OnSample != NULL);
+
+    EC_archiveChunkInfo_t info;
+
+    if (!EC_archive_chunk_info(Data, Size, &info))
+    {
+        return -1;
+    }
+    if ((info.LastTick < From) || (info.FirstTick > To))
+    {
+        return 0;
+    }
+
+    return EC_archive_decode(Data, &info, From, To, OnSample, Context);
+}
+
+/**
+ * Accumulator for EC_archive_ever_set() on partially covered chunks.
+ */
+typedef struct
+{
+    uint64_t Error;
+    uint64_t Warning;
+} EC_archiveEver_t;
+
+static void EC_archive_accumulate(void *Context, const EC_archiveSample_t *Sample)
+{
+    EC_archiveEver_t *ever = (EC_archiveEver_t *)Context;
+
+    ever->Error |= Sample->ErrorReg;
+    ever->Warning |= Sample->WarningReg;
+}
+
+/**
+ * ORs the registers within [From, To], from the header summary where possible.
+ */
+uint8_t EC_archive_ever_set(const uint8_t *Data, size_t Size, uint64_t From, uint64_t To, uint64_t *EverError,
+                            uint64_t *EverWarning)
+{
+    assert(Data != NULL);
+
+    EC_archiveChunkInfo_t info;
+    EC_archiveEver_t ever = {0, 0};
+
+    if (!EC_archive_chunk_info(Data, Size, &info))
+    {
+        return 0;
+    }
+
+    if ((info.LastTick < From) || (info.FirstTick > To))
+    {
+        return 1;
+    }
+
+    if ((info.FirstTick >= From) && (info.LastTick <= To))
+    {
+        ever.Error = info.EverError;
+        ever.Warning = info.EverWarning;
+    }
+    else if (EC_archive_decode(Data, &info, From, To, EC_archive_accumulate, &ever) < 0)
+    {
+        return 0;
+    }
+
+    if (NULL != EverError)
+    {
+        *EverError |= ever.Error;
+    }
+    if (NULL != EverWarning)
+    {
+        *EverWarning |= ever.Warning;
+    }
+
+    return 1;
+}
@@ -0,0 +1,211 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file err_core_archive.h
+ * @brief Error Core - Columnar register history archive
+ *
+ * @details
+ * Stores sampled ErrorReg/WarningReg history for long retention. Samples are
+ * collected into chunks; each chunk is encoded column by column:
+ * - Tick column: LEB128 varint deltas to the previous sample
+ * - ErrorReg and WarningReg columns: XOR with the previous sample, run-length
+ *   encoded as (varint zero-run, varint XOR word) pairs
+ *
+ * Register bits change rarely, so a run of unchanged samples costs one byte
+ * per column. Every chunk header carries the tick range and the OR of all
+ * registers in the chunk, so "was error 17 ever set in this hour" is answered
+ * from the header alone for chunks inside the range and only chunks at the
+ * range edges are decoded.
+ *
+ * Chunk layout (little-endian):
+ * | Offset | Field                                      |
+ * |--------|--------------------------------------------|
+ * | 0      | Magic "ECA" + version                      |
+ * | 4      | Sample count (16 bit), reserved (16 bit)   |
+ * | 8      | First tick, last tick (64 bit each)        |
+ * | 24     | OR of ErrorReg, OR of WarningReg           |
+ * | 40     | Tick, ErrorReg, WarningReg column lengths  |
+ * | 52     | FNV-1a checksum of the columns             |
+ * | 56     | Columns                                    |
+ *
+ * A sample describes the registers at its tick; queries cover samples with
+ * From <= Tick <= To.
+ *
+ * @example Archiving once per second
+ * @code
+ * static EC_archiveSample_t staging[1024];
+ * static uint8_t chunk[EC_ARCHIVE_CHUNK_MAX(1024)];
+ *
+ * EC_archive_init(&archive, staging, 1024, chunk, sizeof(chunk), append_to_file, file);
+ *
+ * void every_second(void) {
+ *     EC_archive_append(&archive, uptime_ms, instance.ErrorReg, instance.WarningReg);
+ * }
+ * @endcode
+ *
+ * @example Was error 17 set during the last hour?
+ * @code
+ * uint64_t hits = 0;
+ * for (each stored chunk) {
+ *     EC_archive_ever_set(data, size, now - 3600000, now, &hits, NULL);
+ * }
+ * if (hits & (1ULL << 17)) { ... }
+ * @endcode
+ */
+
+#ifndef ERR_CORE_ERR_CORE_ARCHIVE_H_
+#define ERR_CORE_ERR_CORE_ARCHIVE_H_
+
+#include "err_core.h"
+
+/*******************************************************************************
+ * CONFIGURATION MACROS
+ ******************************************************************************/
+
+/** @brief Archive chunk format version */
+#define EC_ARCHIVE_VERSION 1u
+
+/** @brief Size of the chunk header in bytes */
+#define EC_ARCHIVE_HEADER_SIZE 56u
+
+/** @brief Worst-case encoded size of a chunk of n samples */
+#define EC_ARCHIVE_CHUNK_MAX(n) (EC_ARCHIVE_HEADER_SIZE + 32u * (size_t)(n))
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @struct EC_archiveSample_t
+ * @brief One register sample
+ */
+typedef struct
+{
+    uint64_t Tick;       /**< Monotonic 64-bit tick */
+    uint64_t ErrorReg;   /**< Error register at Tick */
+    uint64_t WarningReg; /**< Warning register at Tick */
+} EC_archiveSample_t;
+
+/**
+ * @struct EC_archiveChunkInfo_t
+ * @brief Decoded chunk header
+ */
+typedef struct
+{
+    uint64_t FirstTick;   /**< Tick of the first sample */
+    uint64_t LastTick;    /**< Tick of the last sample */
+    uint64_t EverError;   /**< OR of ErrorReg over all samples */
+    uint64_t EverWarning; /**< OR of WarningReg over all samples */
+    uint16_t Count;       /**< Number of samples */
+    size_t Size;          /**< Encoded chunk size in bytes */
+} EC_archiveChunkInfo_t;
+
+/**
+ * @struct EC_archiveWriter_t
+ * @brief Append-only archive writer
+ */
+typedef struct
+{
+    EC_archiveSample_t *Samples; /**< Staging area of the open chunk */
+    uint16_t Capacity;           /**< Samples per chunk */
+    uint16_t Count;              /**< Samples in the open chunk */
+    uint8_t *Chunk;              /**< Encoding buffer */
+    size_t ChunkSize;            /**< Size of Chunk */
+
+    /**
+     * @brief Chunk sink - receives every encoded chunk
+     */
+    void (*Sink)(void *Context, const uint8_t *Data, size_t Size);
+    void *Context; /**< User pointer passed to Sink */
+} EC_archiveWriter_t;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief Initializes an archive writer
+ *
+ * @param[out] Writer    Writer to initialize
+ * @param[in]  Samples   Staging array for one chunk
+ * @param[in]  Capacity  Number of entries in Samples (samples per chunk, 1-65535)
+ * @param[in]  Chunk     Encoding buffer
+ * @param[in]  ChunkSize Size of Chunk (>= EC_ARCHIVE_CHUNK_MAX(Capacity))
+ * @param[in]  Sink      Callback receiving every encoded chunk
+ * @param[in]  Context   User pointer passed to Sink
+ */
+void EC_archive_init(EC_archiveWriter_t *Writer, EC_archiveSample_t *Samples, uint16_t Capacity, uint8_t *Chunk,
+                     size_t ChunkSize, void (*Sink)(void *Context, const uint8_t *Data, size_t Size),
+                     void *Context);
+
+/**
+ * @brief Appends one sample, emitting a chunk when the staging area is full
+ *
+ * @param[in,out] Writer     Archive writer
+ * @param[in]     Tick       Sample tick (must not decrease)
+ * @param[in]     ErrorReg   Error register
+ * @param[in]     WarningReg Warning register
+ */
+void EC_archive_append(EC_archiveWriter_t *Writer, uint64_t Tick, uint64_t ErrorReg, uint64_t WarningReg);
+
+/**
+ * @brief Encodes and emits the open chunk if it holds any samples
+ */
+void EC_archive_flush(EC_archiveWriter_t *Writer);
+
+/**
+ * @brief Validates a chunk and reads its header
+ *
+ * @param[in]  Data Chunk data
+ * @param[in]  Size Bytes available at Data (may cover further chunks)
+ * @param[out] Info Decoded header
+ *
+ * @return 1 if the chunk is valid, 0 otherwise
+ */
+uint8_t EC_archive_chunk_info(const uint8_t *Data, size_t Size, EC_archiveChunkInfo_t *Info);
+
+/**
+ * @brief Calls OnSample for every sample of a chunk within [From, To]
+ *
+ * @param[in] Data     Chunk data
+ * @param[in] Size     Bytes available at Data
+ * @param[in] From     First tick of the range
+ * @param[in] To       Last tick of the range
+ * @param[in] OnSample Callback for every sample in the range
+ * @param[in] Context  User pointer passed to OnSample
+ *
+ * @return Number of samples reported, -1 if the chunk is invalid
+ *
+ * @note Chunks outside the range are rejected from the header without decoding
+ */
+int32_t EC_archive_scan(const uint8_t *Data, size_t Size, uint64_t From, uint64_t To,
+                        void (*OnSample)(void *Context, const EC_archiveSample_t *Sample), void *Context);
+
+/**
+ * @brief ORs the registers of all samples of a chunk within [From, To] into the results
+ *
+ * Chunks entirely inside the range are answered from the header summary,
+ * chunks entirely outside are skipped; only chunks crossing a range edge are
+ * decoded.
+ *
+ * @param[in]     Data        Chunk data
+ * @param[in]     Size        Bytes available at Data
+ * @param[in]     From        First tick of the range
+ * @param[in]     To          Last tick of the range
+ * @param[in,out] EverError   Accumulated OR of ErrorReg (may be NULL)
+ * @param[in,out] EverWarning Accumulated OR of WarningReg (may be NULL)
+ *
+ * @return 1 on success, 0 if the chunk is invalid
+ */
+uint8_t EC_archive_ever_set(const uint8_t *Data, size_t Size, uint64_t From, uint64_t To, uint64_t *EverError,
+                            uint64_t *EverWarning);
+
+#endif /* ERR_CORE_ERR_CORE_ARCHIVE_H_ */
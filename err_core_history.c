@@ -0,0 +1,215 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#include "err_core_history.h"
+#include "assert.h"
+#include "string.h"
+
+/**
+ * Stores the full state of the instance as checkpoint for event Seq.
+ */
+static void EC_history_checkpoint(EC_history_t *History, const EC_instance_t *Instance, uint64_t Seq)
+{
+    uint16_t slot = (uint16_t)((Seq / History->Interval) % History->NumCheckpoints);
+    EC_historyCheckpoint_t *checkpoint = &History->Checkpoints[slot];
+
+    checkpoint->Tick = History->Tick;
+    checkpoint->Seq = Seq;
+    checkpoint->ErrorReg = Instance->ErrorReg;
+    checkpoint->WarningReg = Instance->WarningReg;
+    memcpy(&History->CheckpointRuntime[(size_t)slot * History->NumberOfErrors], Instance->RuntimeData,
+           (size_t)History->NumberOfErrors * sizeof(EC_runtimeData_t));
+}
+
+/**
+ * Initializes the history with the current state of the instance.
+ */
+void EC_history_init(EC_history_t *History, const EC_instance_t *Instance, EC_TIME_t Tick,
+                     EC_historyEvent_t *Events, EC_historyCheckpoint_t *Checkpoints,
+                     EC_runtimeData_t *CheckpointRuntime, uint16_t NumCheckpoints, uint16_t Interval)
+{
+    assert(History != NULL);
+    assert(Instance != NULL);
+    assert(Events != NULL);
+    assert(Checkpoints != NULL);
+    assert(CheckpointRuntime != NULL);
+    assert(NumCheckpoints >= 2);
+    assert(Interval >= 1);
+
+    History->Events = Events;
+    History->Checkpoints = Checkpoints;
+    History->CheckpointRuntime = CheckpointRuntime;
+    History->NextSeq = 0;
+    History->Tick = (uint64_t)Tick;
+    History->LastTick = Tick;
+    History->NumCheckpoints = NumCheckpoints;
+    History->Interval = Interval;
+    History->NumberOfErrors = Instance->NumberOfErrors;
+
+    EC_history_checkpoint(History, Instance, 0);
+}
+
+/**
+ * Records one transition and takes a checkpoint every Interval events.
+ */
+void EC_history_transition(void *Context, const EC_instance_t *Instance, uint8_t ErrorNumber,
+                           EC_transition_t Transition, EC_TIME_t Tick)
+{
+    EC_history_t *History = (EC_history_t *)Context;
+
+    assert(History != NULL);
+    assert(Instance != NULL);
+    assert(ErrorNumber < History->NumberOfErrors);
+
+    uint64_t capacity = (uint64_t)History->NumCheckpoints * History->Interval;
+    EC_historyEvent_t *event = &History->Events[History->NextSeq % capacity];
+
+    History->Tick += (EC_TIME_t)(Tick - History->LastTick);
+    History->LastTick = Tick;
+
+    event->Tick = History->Tick;
+    event->Runtime = Instance->RuntimeData[ErrorNumber];
+    event->ErrorNumber = ErrorNumber;
+    event->Transition = (uint8_t)Transition;
+    if (EC_TRANSITION_RESET == Transition)
+    {
+        // EC_poll() clears WarningPending right after reporting the reset
+        event->Runtime.WarningPending = 0;
+    }
+
+    History->NextSeq++;
+
+    if (0 == History->NextSeq % History->Interval)
+    {
+        EC_history_checkpoint(History, Instance, History->NextSeq);
+        if (EC_TRANSITION_RESET == Transition)
+        {
+            uint16_t slot = (uint16_t)((History->NextSeq / History->Interval) % History->NumCheckpoints);
+            History->CheckpointRuntime[(size_t)slot * History->NumberOfErrors + ErrorNumber].WarningPending = 0;
+        }
+    }
+}
+
+#if EC_USE_TRANSITION_HOOK
+
+/**
+ * Connects an instance to a history store.
+ */
+void EC_history_attach(EC_history_t *History, EC_instance_t *Instance)
+{
+    assert(History != NULL);
+    assert(Instance != NULL);
+
+    EC_transition_callback_register(Instance, EC_history_transition, History);
+}
+
+#endif
+
+/**
+ * Extends a current raw tick to the history timeline.
+ */
+uint64_t EC_history_now(const EC_history_t *History, EC_TIME_t Tick)
+{
+    assert(History != NULL);
+
+    return History->Tick + (EC_TIME_t)(Tick - History->LastTick);
+}
+
+/**
+ * Returns the index of the oldest retained checkpoint.
+ */
+static uint64_t EC_history_oldestIndex(const EC_history_t *History)
+{
+    uint64_t newest = History->NextSeq / History->Interval;
+
+    return (newest >= History->NumCheckpoints) ? (newest - History->NumCheckpoints + 1u) : 0u;
+}
+
+/**
+ * Returns the oldest extended tick that can be reconstructed.
+ */
+uint64_t EC_history_oldest(const EC_history_t *History)
+{
+    assert(History != NULL);
+
+    uint64_t index = EC_history_oldestIndex(History);
+
+    return History->Checkpoints[index % History->NumCheckpoints].Tick;
+}
+
+/**
+ * Reconstructs the state at Tick from the nearest checkpoint plus a short replay.
+ */
+int EC_history_state_at(const EC_history_t *History, uint64_t Tick, uint64_t *ErrorReg, uint64_t *WarningReg,
+                        EC_runtimeData_t *RuntimeData)
+{
+    assert(History != NULL);
+
+    uint64_t low = EC_history_oldestIndex(History);
+    uint64_t high = History->NextSeq / History->Interval;
+
+    if (Tick < History->Checkpoints[low % History->NumCheckpoints].Tick)
+    {
+        return -1;
+    }
+
+    // Last checkpoint with checkpoint tick <= Tick
+    while (low < high)
+    {
+        uint64_t mid = low + (high - low + 1u) / 2u;
+
+        if (History->Checkpoints[mid % History->NumCheckpoints].Tick <= Tick)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1u;
+        }
+    }
+
+    uint16_t slot = (uint16_t)(low % History->NumCheckpoints);
+    const EC_historyCheckpoint_t *checkpoint = &History->Checkpoints[slot];
+    uint64_t error_reg = checkpoint->ErrorReg;
+    uint64_t warning_reg = checkpoint->WarningReg;
+
+    if (NULL != RuntimeData)
+    {
+        memcpy(RuntimeData, &History->CheckpointRuntime[(size_t)slot * History->NumberOfErrors],
+               (size_t)History->NumberOfErrors * sizeof(EC_runtimeData_t));
+    }
+
+    uint64_t capacity = (uint64_t)History->NumCheckpoints * History->Interval;
+    for (uint64_t seq = checkpoint->Seq; seq < History->NextSeq; seq++)
+    {
+        const EC_historyEvent_t *event = &History->Events[seq % capacity];
+
+        if (event->Tick > Tick)
+        {
+            break;
+        }
+        EC_transition_apply(&error_reg, &warning_reg, event->ErrorNumber, (EC_transition_t)event->Transition);
+        if (NULL != RuntimeData)
+        {
+            RuntimeData[event->ErrorNumber] = event->Runtime;
+        }
+    }
+
+    if (NULL != ErrorReg)
+    {
+        *ErrorReg = error_reg;
+    }
+    if (NULL != WarningReg)
+    {
+        *WarningReg = warning_reg;
+    }
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file err_core_history.h
+ * @brief Error Core - Indexed state history with time-travel queries
+ *
+ * @details
+ * Records the transition stream of an instance together with the runtime
+ * data of the affected error and takes a full-state checkpoint every
+ * Interval events. EC_history_state_at() reconstructs ErrorReg, WarningReg
+ * and every EC_runtimeData_t as they were at any retained past tick:
+ * binary search for the nearest checkpoint at or before the tick, then a
+ * replay of at most Interval events.
+ *
+ * Storage is two caller-provided rings:
+ * - Events: Checkpoints * Interval entries
+ * - Checkpoints: Checkpoints entries plus Checkpoints * NumberOfErrors runtime records
+ * The oldest Interval events are discarded together with their checkpoint.
+ *
+ * Ticks are extended to 64 bits internally, so queries across tick counter
+ * wrap-around are unambiguous. EC_history_now() converts a current raw tick.
+ *
+ * @note LastNoErr is refreshed by EC_poll() on every poll while a condition
+ *       is absent, without a transition. The reconstructed LastNoErr is the
+ *       value as of the last transition of that error before the queried tick.
+ * @note Clearing an error that has no active warning or error emits no
+ *       transition; its runtime reset is picked up at its next transition.
+ *
+ * @example Recording and querying
+ * @code
+ * static EC_historyEvent_t events[64 * 32];
+ * static EC_historyCheckpoint_t checkpoints[64];
+ * static EC_runtimeData_t checkpoint_runtime[64 * NUM_ERRORS];
+ * static EC_history_t history;
+ *
+ * EC_history_init(&history, &instance, system_tick, events, checkpoints, checkpoint_runtime, 64, 32);
+ * EC_history_attach(&history, &instance);
+ *
+ * // Incident investigation
+ * uint64_t error_reg, warning_reg;
+ * EC_runtimeData_t runtime[NUM_ERRORS];
+ * uint64_t t = EC_history_now(&history, system_tick) - 5000;   // 5 s ago at 1 kHz
+ * if (EC_history_state_at(&history, t, &error_reg, &warning_reg, runtime) == 0) { ... }
+ * @endcode
+ */
+
+#ifndef ERR_CORE_ERR_CORE_HISTORY_H_
+#define ERR_CORE_ERR_CORE_HISTORY_H_
+
+#include "err_core.h"
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @struct EC_historyEvent_t
+ * @brief One recorded transition
+ */
+typedef struct
+{
+    uint64_t Tick;            /**< Extended 64-bit tick of the transition */
+    EC_runtimeData_t Runtime; /**< Runtime data of the error after the transition */
+    uint8_t ErrorNumber;      /**< Index of the error (0-63) */
+    uint8_t Transition;       /**< EC_transition_t */
+} EC_historyEvent_t;
+
+/**
+ * @struct EC_historyCheckpoint_t
+ * @brief Full register state before event Seq
+ */
+typedef struct
+{
+    uint64_t Tick;       /**< Extended tick from which this state is valid */
+    uint64_t Seq;        /**< Sequence number of the first event after the checkpoint */
+    uint64_t ErrorReg;   /**< Error register */
+    uint64_t WarningReg; /**< Warning register */
+} EC_historyCheckpoint_t;
+
+/**
+ * @struct EC_history_t
+ * @brief History store of one instance
+ */
+typedef struct
+{
+    EC_historyEvent_t *Events;           /**< Event ring (Checkpoints * Interval entries) */
+    EC_historyCheckpoint_t *Checkpoints; /**< Checkpoint ring */
+    EC_runtimeData_t *CheckpointRuntime; /**< NumberOfErrors runtime records per checkpoint */
+    uint64_t NextSeq;                    /**< Sequence number of the next event */
+    uint64_t Tick;                       /**< Extended tick of the last event */
+    EC_TIME_t LastTick;                  /**< Raw tick of the last event */
+    uint16_t NumCheckpoints;             /**< Checkpoint ring size */
+    uint16_t Interval;                   /**< Events between checkpoints */
+    uint8_t NumberOfErrors;              /**< Errors of the recorded instance */
+} EC_history_t;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief Initializes a history store with the current state of an instance
+ *
+ * @param[out] History           History to initialize
+ * @param[in]  Instance          Initialized instance
+ * @param[in]  Tick              Current tick (becomes extended tick Tick)
+ * @param[in]  Events            Event ring, NumCheckpoints * Interval entries
+ * @param[in]  Checkpoints       Checkpoint ring, NumCheckpoints entries
+ * @param[in]  CheckpointRuntime NumCheckpoints * NumberOfErrors runtime records
+ * @param[in]  NumCheckpoints    Checkpoint ring size (>= 2)
+ * @param[in]  Interval          Events between checkpoints (>= 1), bounds the replay length
+ */
+void EC_history_init(EC_history_t *History, const EC_instance_t *Instance, EC_TIME_t Tick,
+                     EC_historyEvent_t *Events, EC_historyCheckpoint_t *Checkpoints,
+                     EC_runtimeData_t *CheckpointRuntime, uint16_t NumCheckpoints, uint16_t Interval);
+
+/**
+ * @brief Transition callback recording into a history store
+ *
+ * Matches EC_transition_cb_t with an EC_history_t as Context.
+ */
+void EC_history_transition(void *Context, const EC_instance_t *Instance, uint8_t ErrorNumber,
+                           EC_transition_t Transition, EC_TIME_t Tick);
+
+#if EC_USE_TRANSITION_HOOK
+
+/**
+ * @brief Connects an instance to a history store
+ *
+ * Registers EC_history_transition() as the transition callback of Instance.
+ */
+void EC_history_attach(EC_history_t *History, EC_instance_t *Instance);
+
+#endif
+
+/**
+ * @brief Extends a current raw tick to the 64-bit timeline of the history
+ *
+ * @param[in] History History store
+ * @param[in] Tick    Raw tick no older than one tick wrap period since the last event
+ * @return Extended tick
+ */
+uint64_t EC_history_now(const EC_history_t *History, EC_TIME_t Tick);
+
+/**
+ * @brief Returns the oldest extended tick that can be reconstructed
+ */
+uint64_t EC_history_oldest(const EC_history_t *History);
+
+/**
+ * @brief Reconstructs the instance state at a past tick
+ *
+ * @param[in]  History     History store
+ * @param[in]  Tick        Extended tick to reconstruct (events at Tick are included)
+ * @param[out] ErrorReg    Error register at Tick (may be NULL)
+ * @param[out] WarningReg  Warning register at Tick (may be NULL)
+ * @param[out] RuntimeData NumberOfErrors runtime records at Tick (may be NULL)
+ *
+ * @return 0 on success, -1 if Tick is older than the retained history
+ *
+ * @note Execution time: O(log NumCheckpoints + Interval + NumberOfErrors)
+ */
+int EC_history_state_at(const EC_history_t *History, uint64_t Tick, uint64_t *ErrorReg, uint64_t *WarningReg,
+                        EC_runtimeData_t *RuntimeData);
+
+#endif /* ERR_CORE_ERR_CORE_HISTORY_H_ */
@@ -0,0 +1,276 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "err_core_journal.h"
+#include "assert.h"
+#include "errno.h"
+#include "fcntl.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#include "unistd.h"
+
+/**
+ * FNV-1a checksum over the record fields preceding Checksum.
+ */
+static uint32_t EC_journal_checksum(const EC_journalRecord_t *Record)
+{
+    const uint8_t *data = (const uint8_t *)Record;
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < offsetof(EC_journalRecord_t, Checksum); i++)
+    {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * Returns 1 if the slot holds a complete record.
+ */
+static uint8_t EC_journal_valid(const EC_journalRecord_t *Record)
+{
+    return (0 != Record->Seq) && (Record->Checksum == EC_journal_checksum(Record));
+}
+
+/**
+ * Returns the highest valid sequence number in the ring, 0 if empty.
+ */
+static uint64_t EC_journal_newest(const EC_journal_t *Journal)
+{
+    uint64_t newest = 0;
+
+    for (uint32_t i = 0; i < Journal->Header->Capacity; i++)
+    {
+        const EC_journalRecord_t *record = &Journal->Records[i];
+
+        if (EC_journal_valid(record) && (record->Seq % Journal->Header->Capacity == i) && (record->Seq > newest))
+        {
+            newest = record->Seq;
+        }
+    }
+
+    return newest;
+}
+
+/**
+ * Opens or creates the journal file and maps it.
+ */
+int EC_journal_open(EC_journal_t *Journal, const char *Path, uint32_t Capacity)
+{
+    assert(Journal != NULL);
+    assert(Path != NULL);
+
+    Journal->Fd = open(Path, O_RDWR | O_CREAT, 0644);
+    if (Journal->Fd < 0)
+    {
+        return -1;
+    }
+
+    // Reuse an existing journal when its header is valid
+    EC_journalHeader_t header;
+    struct stat st;
+    uint8_t reuse = 0;
+
+    if (0 != fstat(Journal->Fd, &st))
+    {
+        close(Journal->Fd);
+        return -1;
+    }
+    if (0 != st.st_size)
+    {
+        // Only new or empty files are formatted. Anything else is never wiped implicitly: it may
+        // be unrelated data, and the history of a journal is what survives a crash.
+        if (((size_t)st.st_size < sizeof(header)) ||
+            (pread(Journal->Fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) ||
+            (EC_JOURNAL_MAGIC != header.Magic) || (EC_JOURNAL_VERSION != header.Version) ||
+            (sizeof(EC_journalRecord_t) != header.RecordSize) || (0 == header.Capacity) ||
+            ((size_t)st.st_size < sizeof(header) + (size_t)header.Capacity * sizeof(EC_journalRecord_t)))
+        {
+            close(Journal->Fd);
+            errno = EPROTO;
+            return -1;
+        }
+        if ((0 != Capacity) && (header.Capacity != Capacity))
+        {
+            close(Journal->Fd);
+            errno = EEXIST;
+            return -1;
+        }
+
+        reuse = 1;
+        Capacity = header.Capacity;
+    }
+
+    if (0 == Capacity)
+    {
+        close(Journal->Fd);
+        errno = EINVAL;
+        return -1;
+    }
+
+    Journal->MapSize = sizeof(EC_journalHeader_t) + (size_t)Capacity * sizeof(EC_journalRecord_t);
+
+    if (!reuse && (0 != ftruncate(Journal->Fd, (off_t)Journal->MapSize)))
+    {
+        close(Journal->Fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, Journal->MapSize, PROT_READ | PROT_WRITE, MAP_SHARED, Journal->Fd, 0);
+    if (MAP_FAILED == map)
+    {
+        close(Journal->Fd);
+        return -1;
+    }
+
+    Journal->Header = (EC_journalHeader_t *)map;
+    Journal->Records = (EC_journalRecord_t *)((uint8_t *)map + sizeof(EC_journalHeader_t));
+
+    if (!reuse)
+    {
+        Journal->Header->Version = EC_JOURNAL_VERSION;
+        Journal->Header->RecordSize = sizeof(EC_journalRecord_t);
+        Journal->Header->Capacity = Capacity;
+        Journal->Header->Reserved = 0;
+        // Magic last - a header torn during creation is not accepted on reopen
+        Journal->Header->Magic = EC_JOURNAL_MAGIC;
+    }
+
+    Journal->NextSeq = EC_journal_newest(Journal) + 1;
+
+    return 0;
+}
+
+/**
+ * Unmaps and closes the journal.
+ */
+void EC_journal_close(EC_journal_t *Journal)
+{
+    assert(Journal != NULL);
+
+    if (NULL != Journal->Header)
+    {
+        munmap(Journal->Header, Journal->MapSize);
+        close(Journal->Fd);
+        Journal->Header = NULL;
+        Journal->Records = NULL;
+    }
+}
+
+/**
+ * Appends one record to the ring.
+ */
+void EC_journal_record(EC_journal_t *Journal, uint16_t Source, uint8_t ErrorNumber, EC_transition_t Transition,
+                       EC_TIME_t Tick, uint64_t ErrorReg, uint64_t WarningReg)
+{
+    assert(Journal != NULL);
+    assert(Journal->Records != NULL);
+
+    uint64_t seq = Journal->NextSeq++;
+    EC_journalRecord_t record = {
+        .Seq = seq,
+        .Tick = (uint64_t)Tick,
+        .ErrorReg = ErrorReg,
+        .WarningReg = WarningReg,
+        .Source = Source,
+        .ErrorNumber = ErrorNumber,
+        .Transition = (uint8_t)Transition,
+    };
+    record.Checksum = EC_journal_checksum(&record);
+
+    Journal->Records[seq % Journal->Header->Capacity] = record;
+}
+
+/**
+ * Transition callback writing to a journal port.
+ */
+void EC_journal_transition(void *Context, const EC_instance_t *Instance, uint8_t ErrorNumber,
+                           EC_transition_t Transition, EC_TIME_t Tick)
+{
+    EC_journalPort_t *Port = (EC_journalPort_t *)Context;
+
+    assert(Port != NULL);
+    assert(Instance != NULL);
+
+    EC_journal_record(Port->Journal, Port->Source, ErrorNumber, Transition, Tick, Instance->ErrorReg,
+                      Instance->WarningReg);
+}
+
+#if EC_USE_TRANSITION_HOOK
+
+/**
+ * Connects an instance to a journal port.
+ */
+void EC_journal_attach(EC_journalPort_t *Port, EC_instance_t *Instance)
+{
+    assert(Port != NULL);
+    assert(Instance != NULL);
+
+    EC_transition_callback_register(Instance, EC_journal_transition, Port);
+}
+
+#endif
+
+/**
+ * Flushes the mapping to storage.
+ */
+int EC_journal_sync(EC_journal_t *Journal)
+{
+    assert(Journal != NULL);
+
+    return msync(Journal->Header, Journal->MapSize, MS_SYNC);
+}
+
+/**
+ * Reads back the valid history, oldest record first.
+ */
+uint32_t EC_journal_recover(const EC_journal_t *Journal,
+                            void (*OnRecord)(void *Context, const EC_journalRecord_t *Record), void *Context)
+{
+    assert(Journal != NULL);
+    assert(Journal->Records != NULL);
+
+    uint32_t capacity = Journal->Header->Capacity;
+    uint64_t newest = EC_journal_newest(Journal);
+
+    if (0 == newest)
+    {
+        return 0;
+    }
+
+    // Walk back through consecutive sequence numbers to find the oldest valid record
+    uint64_t oldest = newest;
+    while ((oldest > 1) && (newest - oldest + 1 < capacity))
+    {
+        const EC_journalRecord_t *record = &Journal->Records[(oldest - 1) % capacity];
+
+        if (!EC_journal_valid(record) || (record->Seq != oldest - 1))
+        {
+            break;
+        }
+        oldest--;
+    }
+
+    for (uint64_t seq = oldest; seq <= newest; seq++)
+    {
+        if (NULL != OnRecord)
+        {
+            OnRecord(Context, &Journal->Records[seq % capacity]);
+        }
+    }
+
+    return (uint32_t)(newest - oldest + 1);
+}
@@ -0,0 +1,219 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file err_core_journal.h
+ * @brief Error Core - Crash-survivable persistent event journal (Linux/POSIX)
+ *
+ * @details
+ * Keeps the transition history in a memory-mapped, file-backed ring. A
+ * record write is a handful of plain stores into the mapping - no system
+ * calls - and the kernel keeps the dirty pages even if the process crashes,
+ * so the history leading up to a crash survives and is read back with
+ * EC_journal_recover().
+ *
+ * File layout:
+ * - EC_journalHeader_t (magic, version, record size, capacity)
+ * - Capacity x EC_journalRecord_t, record with sequence number S in slot S % Capacity
+ *
+ * Every record carries a sequence number and a checksum. A record torn by a
+ * crash in the middle of a write fails the checksum and marks the end of the
+ * valid history.
+ *
+ * @note Protects against process crashes. Surviving power loss additionally
+ *       requires EC_journal_sync() at suitable points.
+ * @note One writer per journal file.
+ *
+ * @example Writing
+ * @code
+ * EC_journal_t journal;
+ * EC_journalPort_t port = {&journal, 0};   // source id 0
+ *
+ * if (EC_journal_open(&journal, "/var/lib/app/errors.jnl", 4096) == 0) {
+ *     EC_journal_attach(&port, &instance);
+ * }
+ * @endcode
+ *
+ * @example Recovery after a crash
+ * @code
+ * void print(void *ctx, const EC_journalRecord_t *r) {
+ *     printf("#%llu tick %llu error %u -> %u\n", ...);
+ * }
+ *
+ * EC_journal_t journal;
+ * EC_journal_open(&journal, "/var/lib/app/errors.jnl", 0);   // 0 = use existing capacity
+ * EC_journal_recover(&journal, print, NULL);
+ * @endcode
+ */
+
+#ifndef ERR_CORE_ERR_CORE_JOURNAL_H_
+#define ERR_CORE_ERR_CORE_JOURNAL_H_
+
+#include "err_core.h"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "err_core_journal requires a POSIX system with mmap()"
+#endif
+
+/*******************************************************************************
+ * CONFIGURATION MACROS
+ ******************************************************************************/
+
+/** @brief Journal file magic ("ECJ1") */
+#define EC_JOURNAL_MAGIC 0x314A4345u
+
+/** @brief Journal format version */
+#define EC_JOURNAL_VERSION 1u
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @struct EC_journalHeader_t
+ * @brief Journal file header
+ */
+typedef struct
+{
+    uint32_t Magic;      /**< EC_JOURNAL_MAGIC */
+    uint16_t Version;    /**< EC_JOURNAL_VERSION */
+    uint16_t RecordSize; /**< sizeof(EC_journalRecord_t) */
+    uint32_t Capacity;   /**< Number of record slots */
+    uint32_t Reserved;   /**< Zero */
+} EC_journalHeader_t;
+
+/**
+ * @struct EC_journalRecord_t
+ * @brief One journal record (40 bytes)
+ */
+typedef struct
+{
+    uint64_t Seq;        /**< Sequence number, starts at 1 (0 = empty slot) */
+    uint64_t Tick;       /**< Tick of the transition */
+    uint64_t ErrorReg;   /**< Error register after the transition */
+    uint64_t WarningReg; /**< Warning register after the transition */
+    uint16_t Source;     /**< User-defined source id (e.g. instance number) */
+    uint8_t ErrorNumber; /**< Index of the error (0-63) */
+    uint8_t Transition;  /**< EC_transition_t */
+    uint32_t Checksum;   /**< FNV-1a over all preceding fields */
+} EC_journalRecord_t;
+
+/**
+ * @struct EC_journal_t
+ * @brief Open journal
+ */
+typedef struct
+{
+    EC_journalHeader_t *Header;  /**< Mapped header */
+    EC_journalRecord_t *Records; /**< Mapped record ring */
+    size_t MapSize;              /**< Size of the mapping in bytes */
+    uint64_t NextSeq;            /**< Sequence number of the next record */
+    int Fd;                      /**< File descriptor */
+} EC_journal_t;
+
+/**
+ * @struct EC_journalPort_t
+ * @brief Binds an instance to a journal under a source id
+ *
+ * Used as Context of EC_journal_transition().
+ */
+typedef struct
+{
+    EC_journal_t *Journal; /**< Target journal */
+    uint16_t Source;       /**< Source id written to every record */
+} EC_journalPort_t;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief Opens or creates a journal file and maps it
+ *
+ * An existing journal is reopened and writing resumes after its newest
+ * valid record. Only a new or empty file is formatted with Capacity empty
+ * slots.
+ *
+ * An existing non-empty file is never overwritten: a file without journal
+ * magic (unrelated data, or a journal whose creation was interrupted before
+ * the header was complete), a different Capacity or an incompatible format
+ * fails. To start over, remove the file first.
+ *
+ * @param[out] Journal  Journal to open
+ * @param[in]  Path     File path
+ * @param[in]  Capacity Number of record slots, or 0 to open an existing journal as is
+ *
+ * @return 0 on success, -1 on failure (errno is set: EEXIST if the journal has a
+ *         different capacity, EPROTO if the file is not a journal or its format
+ *         is incompatible or truncated, EINVAL for Capacity 0 without an
+ *         existing journal)
+ */
+int EC_journal_open(EC_journal_t *Journal, const char *Path, uint32_t Capacity);
+
+/**
+ * @brief Unmaps and closes the journal
+ */
+void EC_journal_close(EC_journal_t *Journal);
+
+/**
+ * @brief Appends one record
+ *
+ * @note Plain stores into the mapping, no system calls
+ */
+void EC_journal_record(EC_journal_t *Journal, uint16_t Source, uint8_t ErrorNumber, EC_transition_t Transition,
+                       EC_TIME_t Tick, uint64_t ErrorReg, uint64_t WarningReg);
+
+/**
+ * @brief Transition callback writing to a journal
+ *
+ * Matches EC_transition_cb_t with an EC_journalPort_t as Context.
+ */
+void EC_journal_transition(void *Context, const EC_instance_t *Instance, uint8_t ErrorNumber,
+                           EC_transition_t Transition, EC_TIME_t Tick);
+
+#if EC_USE_TRANSITION_HOOK
+
+/**
+ * @brief Connects an instance to a journal port
+ *
+ * Registers EC_journal_transition() as the transition callback of Instance.
+ */
+void EC_journal_attach(EC_journalPort_t *Port, EC_instance_t *Instance);
+
+#endif
+
+/**
+ * @brief Flushes the mapping to storage (msync)
+ *
+ * Only needed to survive power loss or kernel crashes.
+ *
+ * @return 0 on success, -1 on failure (errno is set)
+ */
+int EC_journal_sync(EC_journal_t *Journal);
+
+/**
+ * @brief Reads back the valid history, oldest record first
+ *
+ * Finds the newest record with a valid checksum and walks back through
+ * consecutive sequence numbers until a gap, a torn record or the ring size
+ * is reached.
+ *
+ * @param[in] Journal  Open journal
+ * @param[in] OnRecord Callback for every recovered record
+ * @param[in] Context  User pointer passed to OnRecord
+ *
+ * @return Number of recovered records
+ *
+ * @note Execution time: O(Capacity)
+ */
+uint32_t EC_journal_recover(const EC_journal_t *Journal,
+                            void (*OnRecord)(void *Context, const EC_journalRecord_t *Record), void *Context);
+
+#endif /* ERR_CORE_ERR_CORE_JOURNAL_H_ */
@@ -0,0 +1,330 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#include "err_core_log.h"
+#include "assert.h"
+#include "string.h"
+
+#define EC_LOG_PADDING 0u
+#define EC_LOG_EVENT 1u
+#define EC_LOG_KEYFRAME 2u
+
+/**
+ * Encodes Value as LEB128 varint, returns number of bytes written (1-10).
+ */
+static uint8_t EC_log_putVarint(uint8_t *Out, uint64_t Value)
+{
+    uint8_t len = 0;
+
+    while (Value >= 0x80u)
+    {
+        Out[len++] = (uint8_t)(Value | 0x80u);
+        Value >>= 7;
+    }
+    Out[len++] = (uint8_t)Value;
+
+    return len;
+}
+
+/**
+ * Decodes a LEB128 varint at Data[*Pos].
+ * Returns 1 on success, 0 if more data is needed, -1 if the varint is invalid.
+ */
+static int EC_log_getVarint(const uint8_t *Data, size_t Size, size_t *Pos, uint64_t *Value)
+{
+    uint64_t value = 0;
+    size_t pos = *Pos;
+
+    for (uint8_t shift = 0; shift < 70; shift += 7)
+    {
+        if (pos >= Size)
+        {
+            return 0;
+        }
+
+        uint8_t byte = Data[pos++];
+        value |= (uint64_t)(byte & 0x7Fu) << shift;
+
+        if (!(byte & 0x80u))
+        {
+            *Pos = pos;
+            *Value = value;
+            return 1;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Writes a keyframe with the shadow state at the start of the block.
+ */
+static void EC_log_keyframe(EC_logWriter_t *Writer)
+{
+    uint8_t *out = &Writer->Block[Writer->Used];
+    uint8_t len = 0;
+
+    len += EC_log_putVarint(&out[len], ((uint64_t)EC_LOG_VERSION << 2) | EC_LOG_KEYFRAME);
+    len += EC_log_putVarint(&out[len], Writer->Tick);
+    len += EC_log_putVarint(&out[len], Writer->ErrorReg);
+    len += EC_log_putVarint(&out[len], Writer->WarningReg);
+
+    Writer->Used = (uint16_t)(Writer->Used + len);
+}
+
+/**
+ * Initializes the log writer.
+ */
+void EC_log_init(EC_logWriter_t *Writer, uint8_t *Block, uint16_t BlockSize,
+                 void (*Sink)(void *Context, const uint8_t *Data, uint16_t Size), void *Context,
+                 const EC_instance_t *Instance, EC_TIME_t Tick)
+{
+    assert(Writer != NULL);
+    assert(Block != NULL);
+    assert(BlockSize >= EC_LOG_MIN_BLOCK);
+    assert(Sink != NULL);
+    assert(Instance != NULL);
+
+    Writer->Block = Block;
+    Writer->BlockSize = BlockSize;
+    Writer->Sink = Sink;
+    Writer->Context = Context;
+    Writer->Tick = (uint64_t)Tick;
+    Writer->LastTick = Tick;
+    Writer->ErrorReg = Instance->ErrorReg;
+    Writer->WarningReg = Instance->WarningReg;
+    Writer->Used = 0;
+
+    EC_log_keyframe(Writer);
+}
+
+#if EC_USE_TRANSITION_HOOK
+
+/**
+ * Connects the writer to the transition stream of an instance.
+ */
+void EC_log_attach(EC_logWriter_t *Writer, EC_instance_t *Instance)
+{
+    assert(Writer != NULL);
+    assert(Instance != NULL);
+
+    EC_transition_callback_register(Instance, EC_log_transition, Writer);
+}
+
+#endif
+
+/**
+ * Appends one transition record.
+ */
+void EC_log_transition(void *Context, const EC_instance_t *Instance, uint8_t ErrorNumber,
+                       EC_transition_t Transition, EC_TIME_t Tick)
+{
+    EC_logWriter_t *Writer = (EC_logWriter_t *)Context;
+
+    assert(Writer != NULL);
+    assert(ErrorNumber < 64);
+    (void)Instance;
+
+    uint8_t record[11];
+    uint64_t delta = (uint64_t)(EC_TIME_t)(Tick - Writer->LastTick);
+
+    if (0 != (delta >> 62))
+    {
+        // Does not fit next to the record type (64-bit EC_TIME_t only) - the keyframe of a new block carries the tick
+        Writer->Tick += delta;
+        Writer->LastTick = Tick;
+        delta = 0;
+        EC_log_flush(Writer);
+    }
+
+    uint8_t len = EC_log_putVarint(record, (delta << 2) | EC_LOG_EVENT);
+    record[len++] = (uint8_t)(((uint8_t)Transition << 6) | ErrorNumber);
+
+    if ((uint16_t)(Writer->Used + len) > Writer->BlockSize)
+    {
+        EC_log_flush(Writer);
+    }
+
+    memcpy(&Writer->Block[Writer->Used], record, len);
+    Writer->Used = (uint16_t)(Writer->Used + len);
+
+    Writer->Tick += delta;
+    Writer->LastTick = Tick;
+    Writer->Events++;
+    EC_transition_apply(&Writer->ErrorReg, &Writer->WarningReg, ErrorNumber, Transition);
+}
+
+/**
+ * Pads and emits the current block, then opens a new one.
+ */
+void EC_log_flush(EC_logWriter_t *Writer)
+{
+    assert(Writer != NULL);
+
+    memset(&Writer->Block[Writer->Used], EC_LOG_PADDING, (size_t)(Writer->BlockSize - Writer->Used));
+    Writer->Sink(Writer->Context, Writer->Block, Writer->BlockSize);
+
+    Writer->Used = 0;
+    EC_log_keyframe(Writer);
+}
+
+/**
+ * Initializes the streaming reader.
+ */
+void EC_log_reader_init(EC_logReader_t *Reader, void (*OnEvent)(void *Context, const EC_logEvent_t *Event),
+                        void *Context)
+{
+    assert(Reader != NULL);
+
+    memset(Reader, 0, sizeof(*Reader));
+    Reader->OnEvent = OnEvent;
+    Reader->Context = Context;
+}
+
+/**
+ * Decodes one record from Data.
+ * Returns 1 and sets *Consumed when complete, 0 if more data is needed, -1 if invalid.
+ * Reader state is only modified once the whole record is available.
+ */
+static int EC_log_parse(EC_logReader_t *Reader, const uint8_t *Data, size_t Size, size_t *Consumed)
+{
+    size_t pos = 0;
+    uint64_t prefix;
+    int status = EC_log_getVarint(Data, Size, &pos, &prefix);
+
+    if (status <= 0)
+    {
+        return status;
+    }
+
+    EC_logEvent_t event;
+
+    switch (prefix & 3u)
+    {
+    case EC_LOG_PADDING:
+        if (0 != prefix)
+        {
+            return -1;
+        }
+        *Consumed = pos;
+        return 1;
+
+    case EC_LOG_EVENT: {
+        if (pos >= Size)
+        {
+            return 0;
+        }
+        uint8_t tag = Data[pos++];
+        *Consumed = pos;
+
+        if (!Reader->Synced)
+        {
+            return 1;
+        }
+
+        Reader->Tick += prefix >> 2;
+        event.ErrorNumber = tag & 0x3Fu;
+        event.Transition = (EC_transition_t)(tag >> 6);
+        event.Keyframe = 0;
+        EC_transition_apply(&Reader->ErrorReg, &Reader->WarningReg, event.ErrorNumber, event.Transition);
+        break;
+    }
+
+    case EC_LOG_KEYFRAME: {
+        uint64_t tick, error_reg, warning_reg;
+
+        if ((prefix >> 2) != EC_LOG_VERSION)
+        {
+            return -1;
+        }
+        if ((status = EC_log_getVarint(Data, Size, &pos, &tick)) <= 0 ||
+            (status = EC_log_getVarint(Data, Size, &pos, &error_reg)) <= 0 ||
+            (status = EC_log_getVarint(Data, Size, &pos, &warning_reg)) <= 0)
+        {
+            return status;
+        }
+        *Consumed = pos;
+
+        Reader->Tick = tick;
+        Reader->ErrorReg = error_reg;
+        Reader->WarningReg = warning_reg;
+        Reader->Synced = 1;
+        event.ErrorNumber = 0;
+        event.Transition = EC_TRANSITION_WARNING;
+        event.Keyframe = 1;
+        break;
+    }
+
+    default:
+        return -1;
+    }
+
+    if (NULL != Reader->OnEvent)
+    {
+        event.Tick = Reader->Tick;
+        event.ErrorReg = Reader->ErrorReg;
+        event.WarningReg = Reader->WarningReg;
+        Reader->OnEvent(Reader->Context, &event);
+    }
+
+    return 1;
+}
+
+/**
+ * Decodes a chunk of log data.
+ */
+void EC_log_reader_feed(EC_logReader_t *Reader, const uint8_t *Data, size_t Size)
+{
+    assert(Reader != NULL);
+    assert((Data != NULL) || (0 == Size));
+
+    size_t pos = 0;
+    size_t consumed = 0;
+
+    while (pos < Size)
+    {
+        int status;
+
+        if (Reader->PartialLen)
+        {
+            // Complete a record split across calls one byte at a time
+            Reader->Partial[Reader->PartialLen++] = Data[pos++];
+            status = EC_log_parse(Reader, Reader->Partial, Reader->PartialLen, &consumed);
+            if ((0 == status) && (Reader->PartialLen < EC_LOG_MAX_RECORD))
+            {
+                continue;
+            }
+            Reader->PartialLen = 0;
+        }
+        else
+        {
+            status = EC_log_parse(Reader, &Data[pos], Size - pos, &consumed);
+            if (status > 0)
+            {
+                pos += consumed;
+                continue;
+            }
+            if ((0 == status) && ((Size - pos) < EC_LOG_MAX_RECORD))
+            {
+                memcpy(Reader->Partial, &Data[pos], Size - pos);
+                Reader->PartialLen = (uint8_t)(Size - pos);
+                return;
+            }
+            pos++;
+        }
+
+        if (status <= 0)
+        {
+            // Invalid record - drop sync and wait for the next keyframe
+            Reader->Corrupt++;
+            Reader->Synced = 0;
+        }
+    }
+}
@@ -0,0 +1,214 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file err_core_log.h
+ * @brief Error Core - Compact binary event log
+ *
+ * @details
+ * Encodes the transition stream of an instance into a compact binary log and
+ * decodes it back with a streaming reader. Instead of writing full register
+ * snapshots every poll, only transitions are stored:
+ *
+ * Record layout - every record starts with a LEB128 varint V:
+ * | V & 3 | Record    | V >> 2          | Payload                                  |
+ * |-------|-----------|-----------------|------------------------------------------|
+ * | 0     | Padding   | 0 (single 0x00) | none                                     |
+ * | 1     | Event     | tick delta      | 1 byte: Transition << 6 or ErrorNumber   |
+ * | 2     | Keyframe  | format version  | varint tick, varint ErrorReg, WarningReg |
+ * | 3     | Reserved  |                 |                                          |
+ *
+ * A typical event takes 2-3 bytes. The log is cut into fixed-size blocks;
+ * every block starts with a keyframe holding the absolute tick and the full
+ * registers and is padded with 0x00 to the block size. Block N therefore
+ * starts at byte offset N * BlockSize and can be decoded on its own.
+ * A tick delta of 2^62 or more (64-bit EC_TIME_t only) does not fit an event
+ * record; the writer then starts a new block whose keyframe already holds
+ * the tick of that event, and the event follows with delta 0.
+ *
+ * @example Writing a log
+ * @code
+ * void write_block(void *ctx, const uint8_t *data, uint16_t size) {
+ *     fwrite(data, 1, size, (FILE *)ctx);
+ * }
+ *
+ * uint8_t block[512];
+ * EC_logWriter_t writer = {0};
+ *
+ * EC_log_init(&writer, block, sizeof(block), write_block, log_file, &instance, system_tick);
+ * EC_log_attach(&writer, &instance);
+ * @endcode
+ *
+ * @example Reading a log
+ * @code
+ * void on_event(void *ctx, const EC_logEvent_t *ev) {
+ *     printf("%llu: error %u -> %d\n", (unsigned long long)ev->Tick, ev->ErrorNumber, ev->Transition);
+ * }
+ *
+ * EC_logReader_t reader;
+ * EC_log_reader_init(&reader, on_event, NULL);
+ * while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+ *     EC_log_reader_feed(&reader, buf, n);
+ * }
+ * @endcode
+ */
+
+#ifndef ERR_CORE_ERR_CORE_LOG_H_
+#define ERR_CORE_ERR_CORE_LOG_H_
+
+#include "err_core.h"
+
+/*******************************************************************************
+ * CONFIGURATION MACROS
+ ******************************************************************************/
+
+/** @brief Log format version stored in keyframes */
+#define EC_LOG_VERSION 1u
+
+/** @brief Longest encoded record (keyframe: 1 + 3 * 10 bytes) */
+#define EC_LOG_MAX_RECORD 31u
+
+/** @brief Smallest usable block size */
+#define EC_LOG_MIN_BLOCK (2u * EC_LOG_MAX_RECORD)
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @struct EC_logWriter_t
+ * @brief Log encoder state
+ *
+ * @note Initialize to zero before calling EC_log_init()
+ */
+typedef struct
+{
+    uint8_t *Block;     /**< Block buffer (BlockSize bytes) */
+    uint16_t BlockSize; /**< Size of every emitted block */
+    uint16_t Used;      /**< Bytes used in current block */
+
+    /**
+     * @brief Block sink - receives every completed block (always BlockSize bytes)
+     */
+    void (*Sink)(void *Context, const uint8_t *Data, uint16_t Size);
+    void *Context; /**< User pointer passed to Sink */
+
+    uint64_t Tick;       /**< Absolute tick of last record (extended to 64 bits) */
+    EC_TIME_t LastTick;  /**< Raw tick of last record */
+    uint64_t ErrorReg;   /**< Shadow error register (state after last record) */
+    uint64_t WarningReg; /**< Shadow warning register (state after last record) */
+    uint32_t Events;     /**< Number of events written */
+} EC_logWriter_t;
+
+/**
+ * @struct EC_logEvent_t
+ * @brief Decoded log record
+ */
+typedef struct
+{
+    uint64_t Tick;              /**< Absolute tick */
+    uint64_t ErrorReg;          /**< Error register after this record */
+    uint64_t WarningReg;        /**< Warning register after this record */
+    EC_transition_t Transition; /**< Kind of transition (events only) */
+    uint8_t ErrorNumber;        /**< Index of the error (events only) */
+    uint8_t Keyframe;           /**< 1 for keyframes, 0 for events */
+} EC_logEvent_t;
+
+/**
+ * @struct EC_logReader_t
+ * @brief Streaming log decoder state
+ */
+typedef struct
+{
+    void (*OnEvent)(void *Context, const EC_logEvent_t *Event); /**< Record callback */
+    void *Context;                                              /**< User pointer passed to OnEvent */
+
+    uint64_t Tick;       /**< Absolute tick of last record */
+    uint64_t ErrorReg;   /**< Decoded error register */
+    uint64_t WarningReg; /**< Decoded warning register */
+    uint32_t Corrupt;    /**< Number of invalid records skipped */
+
+    uint8_t Partial[EC_LOG_MAX_RECORD]; /**< Record split across feed calls */
+    uint8_t PartialLen;                 /**< Bytes held in Partial */
+    uint8_t Synced;                     /**< Set once a keyframe was decoded */
+} EC_logReader_t;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief Initializes a log writer and opens the first block
+ *
+ * @param[out] Writer    Pointer to writer (must be zeroed)
+ * @param[in]  Block     Block buffer
+ * @param[in]  BlockSize Size of Block (>= EC_LOG_MIN_BLOCK)
+ * @param[in]  Sink      Block sink callback
+ * @param[in]  Context   User pointer passed to Sink
+ * @param[in]  Instance  Instance whose registers seed the first keyframe
+ * @param[in]  Tick      Current tick
+ */
+void EC_log_init(EC_logWriter_t *Writer, uint8_t *Block, uint16_t BlockSize,
+                 void (*Sink)(void *Context, const uint8_t *Data, uint16_t Size), void *Context,
+                 const EC_instance_t *Instance, EC_TIME_t Tick);
+
+#if EC_USE_TRANSITION_HOOK
+
+/**
+ * @brief Connects the writer to the transition stream of an instance
+ *
+ * Registers EC_log_transition() as the transition callback of Instance.
+ */
+void EC_log_attach(EC_logWriter_t *Writer, EC_instance_t *Instance);
+
+#endif
+
+/**
+ * @brief Appends one transition to the log
+ *
+ * Matches EC_transition_cb_t with the writer as Context.
+ *
+ * @note Execution time: O(1), plus one Sink call when a block fills up
+ */
+void EC_log_transition(void *Context, const EC_instance_t *Instance, uint8_t ErrorNumber,
+                       EC_transition_t Transition, EC_TIME_t Tick);
+
+/**
+ * @brief Pads and emits the current block, then opens a new one
+ *
+ * Call before shutdown or whenever buffered events must reach the sink.
+ */
+void EC_log_flush(EC_logWriter_t *Writer);
+
+/**
+ * @brief Initializes a streaming log reader
+ *
+ * @param[out] Reader  Pointer to reader
+ * @param[in]  OnEvent Callback for every decoded event and keyframe
+ * @param[in]  Context User pointer passed to OnEvent
+ */
+void EC_log_reader_init(EC_logReader_t *Reader, void (*OnEvent)(void *Context, const EC_logEvent_t *Event),
+                        void *Context);
+
+/**
+ * @brief Decodes a chunk of log data
+ *
+ * Chunks may be split at any byte; a record spanning two calls is completed
+ * on the next call. Events preceding the first keyframe are skipped. After
+ * an invalid record the reader skips input until the next keyframe - start
+ * feeding at a block boundary to resume.
+ *
+ * @param[in,out] Reader Pointer to reader
+ * @param[in]     Data   Log bytes
+ * @param[in]     Size   Number of bytes
+ */
+void EC_log_reader_feed(EC_logReader_t *Reader, const uint8_t *Data, size_t Size);
+
+#endif /* ERR_CORE_ERR_CORE_LOG_H_ */
@@ -0,0 +1,176 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#include "err_core_notify.h"
+#include "assert.h"
+
+/**
+ * Consumes one unit of rate budget for the error and the instance.
+ * Returns 0 when either budget is exhausted.
+ */
+static uint8_t EC_notify_takeBudget(EC_notifier_t *Notifier, EC_notifyErrorState_t *State, EC_TIME_t Tick)
+{
+    const EC_notifyConfig_t *config = Notifier->Config;
+
+    if (0 == config->RatePeriod)
+    {
+        return 1;
+    }
+
+    if ((EC_TIME_t)(Tick - Notifier->RateWindowStart) >= config->RatePeriod)
+    {
+        Notifier->RateWindowStart = Tick;
+        Notifier->RateCnt = 0;
+    }
+    if ((EC_TIME_t)(Tick - State->RateWindowStart) >= config->RatePeriod)
+    {
+        State->RateWindowStart = Tick;
+        State->RateCnt = 0;
+    }
+
+    if ((config->InstanceRateLimit && (Notifier->RateCnt >= config->InstanceRateLimit)) ||
+        (config->ErrorRateLimit && (State->RateCnt >= config->ErrorRateLimit)))
+    {
+        return 0;
+    }
+
+    Notifier->RateCnt++;
+    State->RateCnt++;
+
+    return 1;
+}
+
+/**
+ * Delivers one notification to the consumer.
+ */
+static void EC_notify_dispatch(EC_notifier_t *Notifier, EC_notifyErrorState_t *State, uint8_t ErrorNumber,
+                               EC_transition_t Transition, EC_TIME_t EventTick, uint16_t Count, EC_TIME_t Tick)
+{
+    EC_notification_t notification = {
+        .Instance = Notifier->Instance,
+        .Tick = EventTick,
+        .Transition = Transition,
+        .Count = Count,
+        .ErrorNumber = ErrorNumber,
+    };
+
+    State->LastDispatch = Tick;
+    State->Dispatched = 1;
+
+    if (NULL != Notifier->Config->Dispatch)
+    {
+        Notifier->Config->Dispatch(Notifier->Config->Context, &notification);
+    }
+}
+
+/**
+ * Initializes the notifier.
+ */
+void EC_notify_init(EC_notifier_t *Notifier, const EC_notifyConfig_t *Config, EC_notifyErrorState_t *States,
+                    uint8_t NumberOfErrors)
+{
+    assert(Notifier != NULL);
+    assert(Config != NULL);
+    assert(States != NULL);
+    assert(NumberOfErrors > 0);
+    assert(NumberOfErrors <= 64);
+
+    Notifier->Config = Config;
+    Notifier->States = States;
+    Notifier->NumberOfErrors = NumberOfErrors;
+}
+
+/**
+ * Connects the notifier to the transition stream of an instance.
+ */
+void EC_notify_attach(EC_notifier_t *Notifier, EC_instance_t *Instance)
+{
+    assert(Notifier != NULL);
+    assert(Instance != NULL);
+    assert(Instance->NumberOfErrors <= Notifier->NumberOfErrors);
+
+    Notifier->Instance = Instance;
+    EC_transition_callback_register(Instance, EC_notify_transition, Notifier);
+}
+
+/**
+ * Dispatches, merges or defers one transition.
+ */
+void EC_notify_transition(void *Context, const EC_instance_t *Instance, uint8_t ErrorNumber,
+                          EC_transition_t Transition, EC_TIME_t Tick)
+{
+    EC_notifier_t *Notifier = (EC_notifier_t *)Context;
+
+    assert(Notifier != NULL);
+    assert(ErrorNumber < Notifier->NumberOfErrors);
+    (void)Instance;
+
+    EC_notifyErrorState_t *state = &Notifier->States[ErrorNumber];
+    uint64_t bit = (uint64_t)1 << ErrorNumber;
+
+    if (Notifier->PendingMask & bit)
+    {
+        // Already deferred - keep only the latest state
+        if (state->PendingCnt < UINT16_MAX)
+        {
+            state->PendingCnt++;
+        }
+        state->PendingTransition = (uint8_t)Transition;
+        state->PendingTick = Tick;
+        state->SuppressedCnt++;
+        Notifier->SuppressedCnt++;
+        return;
+    }
+
+    uint8_t in_window =
+        state->Dispatched && ((EC_TIME_t)(Tick - state->LastDispatch) < Notifier->Config->CoalesceWindow);
+
+    if (!in_window && EC_notify_takeBudget(Notifier, state, Tick))
+    {
+        EC_notify_dispatch(Notifier, state, ErrorNumber, Transition, Tick, 1, Tick);
+        return;
+    }
+
+    // Defer until the window expires and budget is available
+    Notifier->PendingMask |= bit;
+    state->PendingCnt = 1;
+    state->PendingTransition = (uint8_t)Transition;
+    state->PendingTick = Tick;
+}
+
+/**
+ * Dispatches merged notifications whose window has expired.
+ */
+void EC_notify_poll(EC_notifier_t *Notifier, EC_TIME_t Tick)
+{
+    assert(Notifier != NULL);
+
+    uint64_t pending = Notifier->PendingMask;
+    while (pending)
+    {
+        uint8_t i = EC_lowestBit(pending);
+        pending &= pending - 1;
+
+        EC_notifyErrorState_t *state = &Notifier->States[i];
+
+        if (state->Dispatched && ((EC_TIME_t)(Tick - state->LastDispatch) < Notifier->Config->CoalesceWindow))
+        {
+            continue;
+        }
+        if (!EC_notify_takeBudget(Notifier, state, Tick))
+        {
+            continue;
+        }
+
+        Notifier->PendingMask &= ~((uint64_t)1 << i);
+        EC_notify_dispatch(Notifier, state, i, (EC_transition_t)state->PendingTransition, state->PendingTick,
+                           state->PendingCnt, Tick);
+    }
+}
@@ -0,0 +1,216 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file err_core_notify.h
+ * @brief Error Core - Notification storm control
+ *
+ * @details
+ * Sits between the transition stream of an instance and the consumers
+ * (logging, telemetry, UI). A flapping error can produce hundreds of
+ * transitions per second; the notifier bounds what reaches the consumers:
+ * - Coalescing: transitions of one error within CoalesceWindow of the last
+ *   dispatch are merged into a single notification carrying the latest state
+ * - Rate limiting: at most ErrorRateLimit notifications per error and
+ *   InstanceRateLimit per instance in every RatePeriod
+ * - Accounting: every transition absorbed into a merged notification is
+ *   counted, per error and per notifier
+ *
+ * The latest state of an error is never lost - a merged notification stays
+ * pending until the window expires and rate budget is available, then it is
+ * dispatched by EC_notify_poll().
+ *
+ * Requires EC_USE_TRANSITION_HOOK = 1.
+ *
+ * @example Basic Usage
+ * @code
+ * void dispatch(void *ctx, const EC_notification_t *n) {
+ *     log_printf("error %u -> %d (x%u)", n->ErrorNumber, n->Transition, n->Count);
+ * }
+ *
+ * const EC_notifyConfig_t notify_cfg = {
+ *     .CoalesceWindow = 1000,    // merge transitions within 1s
+ *     .RatePeriod = 1000,
+ *     .ErrorRateLimit = 2,       // max 2 notifications per error per second
+ *     .InstanceRateLimit = 20,   // max 20 notifications per instance per second
+ *     .Dispatch = dispatch,
+ * };
+ *
+ * EC_notifyErrorState_t notify_states[NUM_ERRORS] = {0};
+ * EC_notifier_t notifier = {0};
+ *
+ * EC_notify_init(&notifier, &notify_cfg, notify_states, NUM_ERRORS);
+ * EC_notify_attach(&notifier, &instance);
+ *
+ * while(1) {
+ *     EC_poll(&instance);
+ *     EC_notify_poll(&notifier, system_tick);
+ * }
+ * @endcode
+ */
+
+#ifndef ERR_CORE_ERR_CORE_NOTIFY_H_
+#define ERR_CORE_ERR_CORE_NOTIFY_H_
+
+#include "err_core.h"
+
+#if !EC_USE_TRANSITION_HOOK
+#error "err_core_notify requires EC_USE_TRANSITION_HOOK = 1"
+#endif
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @struct EC_notification_t
+ * @brief Notification delivered to the consumer
+ */
+typedef struct
+{
+    const EC_instance_t *Instance; /**< Instance the error belongs to */
+    EC_TIME_t Tick;                /**< Tick of the (latest) transition */
+    EC_transition_t Transition;    /**< Kind of the (latest) transition */
+    uint16_t Count;                /**< Number of transitions represented (1 = not merged) */
+    uint8_t ErrorNumber;           /**< Index of the error (0-63) */
+} EC_notification_t;
+
+/**
+ * @struct EC_notifyConfig_t
+ * @brief Notifier configuration
+ *
+ * @note This structure should be declared as const and stored in flash memory
+ */
+typedef struct
+{
+    /**
+     * @brief Minimum ticks between two notifications of one error
+     *
+     * Transitions arriving sooner are merged. 0 disables coalescing.
+     */
+    EC_TIME_t CoalesceWindow;
+
+    /**
+     * @brief Rate limit period in ticks (0 = no rate limiting)
+     */
+    EC_TIME_t RatePeriod;
+
+    /**
+     * @brief Max notifications per error per RatePeriod (0 = unlimited)
+     */
+    uint16_t ErrorRateLimit;
+
+    /**
+     * @brief Max notifications per instance per RatePeriod (0 = unlimited)
+     */
+    uint16_t InstanceRateLimit;
+
+    /**
+     * @brief Consumer callback
+     *
+     * @param Context      User pointer from this configuration
+     * @param Notification Notification to deliver (valid only during the call)
+     */
+    void (*Dispatch)(void *Context, const EC_notification_t *Notification);
+
+    /**
+     * @brief User pointer passed to Dispatch
+     */
+    void *Context;
+
+} EC_notifyConfig_t;
+
+/**
+ * @struct EC_notifyErrorState_t
+ * @brief Per-error notifier state
+ *
+ * Array must be in RAM and initialized to zero.
+ */
+typedef struct
+{
+    EC_TIME_t LastDispatch;    /**< Tick of the last dispatched notification */
+    EC_TIME_t RateWindowStart; /**< Start of current rate limit window */
+    EC_TIME_t PendingTick;     /**< Tick of the latest merged transition */
+    uint32_t SuppressedCnt;    /**< Transitions absorbed into merged notifications */
+    uint16_t RateCnt;          /**< Notifications dispatched in current rate window */
+    uint16_t PendingCnt;       /**< Transitions merged into the pending notification */
+    uint8_t PendingTransition; /**< Kind of the latest merged transition */
+    uint8_t Dispatched;        /**< Set once the first notification was dispatched */
+} EC_notifyErrorState_t;
+
+/**
+ * @struct EC_notifier_t
+ * @brief Notifier instance
+ *
+ * @note Initialize to zero before calling EC_notify_init()
+ */
+typedef struct
+{
+    const EC_notifyConfig_t *Config; /**< Configuration */
+    EC_notifyErrorState_t *States;   /**< Per-error state array */
+    const EC_instance_t *Instance;   /**< Attached instance */
+    uint64_t PendingMask;            /**< Errors with a pending merged notification */
+    uint32_t SuppressedCnt;          /**< Total transitions absorbed into merged notifications */
+    EC_TIME_t RateWindowStart;       /**< Start of current instance rate window */
+    uint16_t RateCnt;                /**< Notifications dispatched in current instance rate window */
+    uint8_t NumberOfErrors;          /**< Size of States array */
+} EC_notifier_t;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief Initializes a notifier
+ *
+ * @param[out] Notifier       Pointer to notifier (must be zeroed)
+ * @param[in]  Config         Pointer to configuration (must remain valid)
+ * @param[in]  States         Pointer to per-error state array (must be zeroed)
+ * @param[in]  NumberOfErrors Size of States array (1-64)
+ */
+void EC_notify_init(EC_notifier_t *Notifier, const EC_notifyConfig_t *Config, EC_notifyErrorState_t *States,
+                    uint8_t NumberOfErrors);
+
+/**
+ * @brief Connects the notifier to the transition stream of an instance
+ *
+ * Registers EC_notify_transition() as the transition callback of Instance.
+ *
+ * @param[in,out] Notifier Pointer to initialized notifier
+ * @param[in,out] Instance Pointer to initialized instance
+ *
+ * @pre Instance->NumberOfErrors must not exceed Notifier->NumberOfErrors
+ */
+void EC_notify_attach(EC_notifier_t *Notifier, EC_instance_t *Instance);
+
+/**
+ * @brief Feeds one transition into the notifier
+ *
+ * Matches EC_transition_cb_t with the notifier as Context. Use it directly
+ * when the transition callback of the instance is shared with other consumers.
+ *
+ * @note Execution time: O(1)
+ */
+void EC_notify_transition(void *Context, const EC_instance_t *Instance, uint8_t ErrorNumber,
+                          EC_transition_t Transition, EC_TIME_t Tick);
+
+/**
+ * @brief Dispatches merged notifications whose window has expired
+ *
+ * Call periodically, e.g. right after EC_poll().
+ *
+ * @param[in,out] Notifier Pointer to notifier
+ * @param[in]     Tick     Current tick
+ *
+ * @note Execution time: O(number of pending notifications)
+ */
+void EC_notify_poll(EC_notifier_t *Notifier, EC_TIME_t Tick);
+
+#endif /* ERR_CORE_ERR_CORE_NOTIFY_H_ */
@@ -0,0 +1,427 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#include "err_core_prom.h"
+#include "assert.h"
+#include "string.h"
+
+#if EC_USE_STATS
+typedef EC_stats_t EC_promStats_t;
+#else
+typedef uint8_t EC_promStats_t;
+#endif
+
+/**
+ * Metric family descriptor.
+ */
+typedef struct
+{
+    const char *Name;
+    const char *Help;
+    const char *Type;
+    uint8_t Width;
+    uint8_t NeedsStats;
+    uint64_t (*Get)(const EC_instance_t *Instance, const EC_promStats_t *Stats, uint8_t Index);
+} EC_promFamily_t;
+
+static uint64_t EC_prom_errorActive(const EC_instance_t *Instance, const EC_promStats_t *Stats, uint8_t Index)
+{
+    (void)Stats;
+    return (EC_publishedErrorReg(Instance) >> Index) & 1u;
+}
+
+static uint64_t EC_prom_warningActive(const EC_instance_t *Instance, const EC_promStats_t *Stats, uint8_t Index)
+{
+    (void)Stats;
+    return (EC_publishedWarningReg(Instance) >> Index) & 1u;
+}
+
+static uint64_t EC_prom_warningCnt(const EC_instance_t *Instance, const EC_promStats_t *Stats, uint8_t Index)
+{
+    (void)Stats;
+    return Instance->RuntimeData[Index].WarningCnt;
+}
+
+#if EC_USE_STATS
+
+static uint64_t EC_prom_warnings(const EC_instance_t *Instance, const EC_promStats_t *Stats, uint8_t Index)
+{
+    (void)Instance;
+    return Stats[Index].WarningCount;
+}
+
+static uint64_t EC_prom_errors(const EC_instance_t *Instance, const EC_promStats_t *Stats, uint8_t Index)
+{
+    (void)Instance;
+    return Stats[Index].ErrorCount;
+}
+
+static uint64_t EC_prom_presences(const EC_instance_t *Instance, const EC_promStats_t *Stats, uint8_t Index)
+{
+    (void)Instance;
+    return Stats[Index].PresenceCount;
+}
+
+static uint64_t EC_prom_warningTicks(const EC_instance_t *Instance, const EC_promStats_t *Stats, uint8_t Index)
+{
+    (void)Instance;
+    return Stats[Index].TimeInWarning;
+}
+
+static uint64_t EC_prom_errorTicks(const EC_instance_t *Instance, const EC_promStats_t *Stats, uint8_t Index)
+{
+    (void)Instance;
+    return Stats[Index].TimeInError;
+}
+
+static uint64_t EC_prom_maxPresence(const EC_instance_t *Instance, const EC_promStats_t *Stats, uint8_t Index)
+{
+    (void)Instance;
+    return (uint64_t)Stats[Index].MaxPresence;
+}
+
+#endif
+
+static const EC_promFamily_t EC_promFamilies[EC_PROM_FAMILIES] = {
+    {"ec_error_active", "Error registered (1) or not (0)", "gauge", 1, 0, EC_prom_errorActive},
+    {"ec_warning_active", "Warning active (1) or not (0)", "gauge", 1, 0, EC_prom_warningActive},
+    {"ec_warning_count", "Warnings counted towards escalation", "gauge", 3, 0, EC_prom_warningCnt},
+#if EC_USE_STATS
+    {"ec_warnings_total", "Warnings registered", "counter", 10, 1, EC_prom_warnings},
+    {"ec_errors_total", "Errors registered", "counter", 10, 1, EC_prom_errors},
+    {"ec_presences_total", "Times the condition became present", "counter", 10, 1, EC_prom_presences},
+    {"ec_warning_ticks_total", "Ticks spent in warning (closed periods)", "counter", 20, 1, EC_prom_warningTicks},
+    {"ec_error_ticks_total", "Ticks spent in error (closed periods)", "counter", 20, 1, EC_prom_errorTicks},
+    {"ec_max_presence_ticks", "Longest continuous presence in ticks", "gauge", 20, 1, EC_prom_maxPresence},
+#endif
+};
+
+
+/**
+ * Bounded text writer; keeps counting past the end so it doubles as a size probe.
+ */
+typedef struct
+{
+    char *Buffer;
+    size_t Size;
+    size_t Length;
+} EC_promWriter_t;
+
+static void EC_prom_putc(EC_promWriter_t *Writer, char Char)
+{
+    if ((NULL != Writer->Buffer) && (Writer->Length < Writer->Size))
+    {
+        Writer->Buffer[Writer->Length] = Char;
+    }
+    Writer->Length++;
+}
+
+static void EC_prom_puts(EC_promWriter_t *Writer, const char *String)
+{
+    while (*String)
+    {
+        EC_prom_putc(Writer, *String++);
+    }
+}
+
+/**
+ * Writes a label value with the escapes required by the exposition format.
+ */
+static void EC_prom_putLabel(EC_promWriter_t *Writer, const char *String)
+{
+    for (; *String; String++)
+    {
+        if (('\\' == *String) || ('"' == *String))
+        {
+            EC_prom_putc(Writer, '\\');
+            EC_prom_putc(Writer, *String);
+        }
+        else if ('\n' == *String)
+        {
+            EC_prom_puts(Writer, "\\n");
+        }
+        else
+        {
+            EC_prom_putc(Writer, *String);
+        }
+    }
+}
+
+static void EC_prom_putu(EC_promWriter_t *Writer, uint64_t Value)
+{
+    char digits[20];
+    uint8_t len = 0;
+
+    do
+    {
+        digits[len++] = (char)('0' + (Value % 10u));
+        Value /= 10u;
+    } while (Value);
+
+    while (len)
+    {
+        EC_prom_putc(Writer, digits[--len]);
+    }
+}
+
+/**
+ * Formats Value right-aligned and zero-padded into a fixed-width field.
+ */
+static void EC_prom_format(char *Field, uint8_t Width, uint64_t Value)
+{
+    for (uint8_t i = Width; i > 0; i--)
+    {
+        Field[i - 1u] = (char)('0' + (Value % 10u));
+        Value /= 10u;
+    }
+
+    if (Value)
+    {
+        // Does not fit - saturate instead of showing a truncated number
+        memset(Field, '9', Width);
+    }
+}
+
+/**
+ * Returns 1 if the instance has registered statistics.
+ */
+static uint8_t EC_prom_hasStats(const EC_instance_t *Instance)
+{
+#if EC_USE_STATS
+    return (NULL != Instance->Stats);
+#else
+    (void)Instance;
+    return 0;
+#endif
+}
+
+/**
+ * Returns 1 if the family has series for this instance.
+ */
+static uint8_t EC_prom_hasSeries(const EC_promFamily_t *Family, const EC_instance_t *Instance)
+{
+    return !Family->NeedsStats || EC_prom_hasStats(Instance);
+}
+
+/**
+ * Writes the complete text; with a NULL buffer only counts bytes and slots.
+ */
+static void EC_prom_render(EC_promWriter_t *Writer, const EC_promInstance_t *Instances, uint16_t NumInstances,
+                           EC_promSlot_t *Slots, uint32_t *NumSlots, uint32_t *FamilyBase)
+{
+    uint32_t slot = 0;
+
+    for (uint8_t f = 0; f < EC_PROM_FAMILIES; f++)
+    {
+        const EC_promFamily_t *family = &EC_promFamilies[f];
+
+        if (NULL != FamilyBase)
+        {
+            FamilyBase[f] = slot;
+        }
+
+        EC_prom_puts(Writer, "# HELP ");
+        EC_prom_puts(Writer, family->Name);
+        EC_prom_putc(Writer, ' ');
+        EC_prom_puts(Writer, family->Help);
+        EC_prom_puts(Writer, "\n# TYPE ");
+        EC_prom_puts(Writer, family->Name);
+        EC_prom_putc(Writer, ' ');
+        EC_prom_puts(Writer, family->Type);
+        EC_prom_putc(Writer, '\n');
+
+        for (uint16_t n = 0; n < NumInstances; n++)
+        {
+            const EC_instance_t *instance = Instances[n].Instance;
+
+            if (!EC_prom_hasSeries(family, instance))
+            {
+                continue;
+            }
+
+            for (uint8_t i = 0; i < instance->NumberOfErrors; i++)
+            {
+                EC_prom_puts(Writer, family->Name);
+                EC_prom_puts(Writer, "{instance=\"");
+                EC_prom_putLabel(Writer, Instances[n].Name);
+                EC_prom_puts(Writer, "\",error=\"");
+                EC_prom_putu(Writer, i);
+                EC_prom_puts(Writer, "\",helper=\"");
+                EC_prom_putu(Writer, instance->Errors[i].HelperNumber);
+                EC_prom_puts(Writer, "\"} ");
+
+                if (NULL != Slots)
+                {
+                    Slots[slot].Offset = (uint32_t)Writer->Length;
+                    Slots[slot].Width = family->Width;
+                    // Never matches a real value, so the first update renders every field
+                    Slots[slot].Value = UINT64_MAX;
+                    Slots[slot].HasStats = EC_prom_hasStats(instance);
+                }
+                slot++;
+
+                for (uint8_t c = 0; c < family->Width; c++)
+                {
+                    EC_prom_putc(Writer, '0');
+                }
+                EC_prom_putc(Writer, '\n');
+            }
+        }
+    }
+
+    *NumSlots = slot;
+}
+
+/**
+ * Computes the buffer sizes for a registry.
+ */
+void EC_prom_measure(const EC_promInstance_t *Instances, uint16_t NumInstances, size_t *BufferSize,
+                     uint32_t *NumSlots)
+{
+    assert(Instances != NULL);
+    assert(BufferSize != NULL);
+    assert(NumSlots != NULL);
+
+    EC_promWriter_t writer = {NULL, 0, 0};
+    EC_prom_render(&writer, Instances, NumInstances, NULL, NumSlots, NULL);
+    *BufferSize = writer.Length;
+}
+
+/**
+ * Lays out the text and renders the current values.
+ */
+int EC_prom_build(EC_promExporter_t *Exporter, const EC_promInstance_t *Instances, uint16_t NumInstances,
+                  char *Buffer, size_t BufferSize, EC_promSlot_t *Slots, uint32_t MaxSlots)
+{
+    assert(Exporter != NULL);
+    assert(Instances != NULL);
+    assert(Buffer != NULL);
+    assert(Slots != NULL);
+
+    size_t needed_size;
+    uint32_t needed_slots;
+
+    EC_prom_measure(Instances, NumInstances, &needed_size, &needed_slots);
+    if ((needed_size > BufferSize) || (needed_slots > MaxSlots))
+    {
+        return -1;
+    }
+
+    EC_promWriter_t writer = {Buffer, BufferSize, 0};
+    EC_prom_render(&writer, Instances, NumInstances, Slots, &Exporter->NumSlots, Exporter->FamilyBase);
+
+    Exporter->Instances = Instances;
+    Exporter->NumInstances = NumInstances;
+    Exporter->Buffer = Buffer;
+    Exporter->Length = writer.Length;
+    Exporter->Slots = Slots;
+    Exporter->StatsStale = 0;
+    Exporter->NeedsRebuild = 0;
+
+    EC_prom_update(Exporter);
+
+    return 0;
+}
+
+/**
+ * Rewrites the value fields of Count errors of a family starting at Slot, returns the number rewritten.
+ */
+static uint32_t EC_prom_updateFamily(EC_promExporter_t *Exporter, const EC_promFamily_t *Family, EC_promSlot_t *Slot,
+                                     const EC_instance_t *Instance, const EC_promStats_t *Stats, uint8_t Count)
+{
+    uint32_t rewrites = 0;
+
+    for (uint8_t i = 0; i < Count; i++, Slot++)
+    {
+        uint64_t value = Family->Get(Instance, Stats, i);
+        if (value != Slot->Value)
+        {
+            Slot->Value = value;
+            EC_prom_format(&Exporter->Buffer[Slot->Offset], Slot->Width, value);
+            rewrites++;
+        }
+    }
+
+    return rewrites;
+}
+
+/**
+ * Rewrites the value fields that changed since the last update.
+ */
+size_t EC_prom_update(EC_promExporter_t *Exporter)
+{
+    assert(Exporter != NULL);
+    assert(Exporter->Buffer != NULL);
+
+    uint32_t all_base = 0;
+    uint32_t stats_base = 0;
+    uint32_t rewrites = 0;
+
+    for (uint16_t n = 0; n < Exporter->NumInstances; n++)
+    {
+        const EC_instance_t *instance = Exporter->Instances[n].Instance;
+        // Slot layout of the statistics families as fixed by EC_prom_build()
+        uint8_t has_stats = Exporter->Slots[Exporter->FamilyBase[0] + all_base].HasStats;
+
+        for (uint8_t f = 0; f < EC_PROM_FAMILIES; f++)
+        {
+            if (!EC_promFamilies[f].NeedsStats)
+            {
+                rewrites += EC_prom_updateFamily(Exporter, &EC_promFamilies[f],
+                                                 &Exporter->Slots[Exporter->FamilyBase[f] + all_base], instance, NULL,
+                                                 instance->NumberOfErrors);
+            }
+        }
+
+#if EC_USE_STATS
+        if (has_stats != EC_prom_hasStats(instance))
+        {
+            // Registered or removed after the build - the series do not exist or belong to other rows
+            Exporter->NeedsRebuild = 1;
+        }
+        else if (has_stats)
+        {
+            // Small chunks keep the copy off a deep stack; each chunk is consistent on its own
+            EC_stats_t chunk[EC_PROM_STATS_CHUNK];
+            uint8_t count;
+
+            for (uint8_t first = 0; first < instance->NumberOfErrors; first = (uint8_t)(first + count))
+            {
+                count = (uint8_t)(instance->NumberOfErrors - first);
+                count = (count < EC_PROM_STATS_CHUNK) ? count : (uint8_t)EC_PROM_STATS_CHUNK;
+
+                if (!EC_stats_read(instance, chunk, first, count))
+                {
+                    Exporter->StatsStale++;
+                    continue;
+                }
+
+                EC_promSlot_t *slots = &Exporter->Slots[stats_base + first];
+
+                for (uint8_t f = 0; f < EC_PROM_FAMILIES; f++)
+                {
+                    if (EC_promFamilies[f].NeedsStats)
+                    {
+                        rewrites += EC_prom_updateFamily(Exporter, &EC_promFamilies[f], &slots[Exporter->FamilyBase[f]],
+                                                         instance, chunk, count);
+                    }
+                }
+            }
+        }
+#endif
+
+        all_base += instance->NumberOfErrors;
+        stats_base += has_stats ? instance->NumberOfErrors : 0u;
+    }
+
+    Exporter->Rewrites = rewrites;
+
+    return Exporter->Length;
+}
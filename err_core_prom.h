@@ -0,0 +1,181 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file err_core_prom.h
+ * @brief Error Core - Incremental Prometheus text exporter
+ *
+ * @details
+ * Renders the state of a registry of instances in the Prometheus text
+ * exposition format. The text is laid out once by EC_prom_build(): metric
+ * names, HELP/TYPE lines and label sets are written a single time and every
+ * value is given a fixed-width, zero-padded field. EC_prom_update() then only
+ * rewrites the value fields whose value changed since the last scrape - no
+ * allocation and no label formatting on the scrape path.
+ *
+ * Metric families (labels: instance, error, helper):
+ * | Metric                    | Source                         | Type    |
+ * |---------------------------|--------------------------------|---------|
+ * | ec_error_active           | ErrorReg bit                   | gauge   |
+ * | ec_warning_active         | WarningReg bit                 | gauge   |
+ * | ec_warning_count          | WarningCnt                     | gauge   |
+ * | ec_warnings_total         | EC_stats_t.WarningCount (*)    | counter |
+ * | ec_errors_total           | EC_stats_t.ErrorCount (*)      | counter |
+ * | ec_presences_total        | EC_stats_t.PresenceCount (*)   | counter |
+ * | ec_warning_ticks_total    | EC_stats_t.TimeInWarning (*)   | counter |
+ * | ec_error_ticks_total      | EC_stats_t.TimeInError (*)     | counter |
+ * | ec_max_presence_ticks     | EC_stats_t.MaxPresence (*)     | gauge   |
+ *
+ * (*) With EC_USE_STATS only, for instances with registered statistics.
+ *
+ * @note Registers are read without locking; each value is exact, values of
+ *       different errors may come from consecutive polls. Statistics are read
+ *       with EC_stats_read() in chunks of EC_PROM_STATS_CHUNK errors; if a read
+ *       fails the previous values of that chunk are kept and StatsStale counts
+ *       it.
+ *
+ * @example Gateway scrape handler
+ * @code
+ * static const EC_promInstance_t registry[] = {
+ *     {&motor, "motor"},
+ *     {&comm, "comm"},
+ * };
+ * static char text[64 * 1024];
+ * static EC_promSlot_t slots[4096];
+ * static EC_promExporter_t exporter;
+ *
+ * EC_prom_build(&exporter, registry, 2, text, sizeof(text), slots, 4096);
+ *
+ * void on_scrape(int client) {
+ *     size_t len = EC_prom_update(&exporter);
+ *     send(client, text, len, 0);
+ * }
+ * @endcode
+ */
+
+#ifndef ERR_CORE_ERR_CORE_PROM_H_
+#define ERR_CORE_ERR_CORE_PROM_H_
+
+#include "err_core.h"
+
+/*******************************************************************************
+ * CONFIGURATION MACROS
+ ******************************************************************************/
+
+/** @brief Number of metric families (see table above) */
+#define EC_PROM_FAMILIES (3u + (EC_USE_STATS ? 6u : 0u))
+
+/**
+ * @def EC_PROM_STATS_CHUNK
+ * @brief Errors whose statistics EC_prom_update() copies per EC_stats_read() call
+ *
+ * Bounds the stack use of an update to this many EC_stats_t entries, which
+ * are large with EC_USE_HISTOGRAMS.
+ *
+ * @note Default: 4
+ */
+#ifndef EC_PROM_STATS_CHUNK
+#define EC_PROM_STATS_CHUNK 4u
+#endif
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @struct EC_promInstance_t
+ * @brief Registry entry
+ */
+typedef struct
+{
+    const EC_instance_t *Instance; /**< Initialized instance */
+    const char *Name;              /**< Value of the "instance" label */
+} EC_promInstance_t;
+
+/**
+ * @struct EC_promSlot_t
+ * @brief Position and last rendered value of one value field
+ */
+typedef struct
+{
+    uint64_t Value;   /**< Value currently in the text */
+    uint32_t Offset;  /**< Offset of the value field in the text buffer */
+    uint8_t Width;    /**< Field width in characters */
+    uint8_t HasStats; /**< The instance of this series had statistics at build time */
+} EC_promSlot_t;
+
+/**
+ * @struct EC_promExporter_t
+ * @brief Exporter state
+ */
+typedef struct
+{
+    const EC_promInstance_t *Instances;    /**< Registry */
+    uint16_t NumInstances;                 /**< Number of registry entries */
+    char *Buffer;                          /**< Rendered text */
+    size_t Length;                         /**< Length of the rendered text */
+    EC_promSlot_t *Slots;                  /**< One entry per value field */
+    uint32_t NumSlots;                     /**< Number of value fields */
+    uint32_t FamilyBase[EC_PROM_FAMILIES]; /**< First slot of every metric family */
+    uint32_t Rewrites;                     /**< Value fields rewritten by the last update */
+    uint32_t StatsStale;                   /**< Failed statistics reads since the build (values kept) */
+    uint8_t NeedsRebuild;                  /**< Statistics registered or removed since the build */
+} EC_promExporter_t;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief Computes the buffer sizes EC_prom_build() needs for a registry
+ *
+ * @param[in]  Instances    Registry
+ * @param[in]  NumInstances Number of registry entries
+ * @param[out] BufferSize   Required text buffer size in bytes
+ * @param[out] NumSlots     Required number of EC_promSlot_t entries
+ */
+void EC_prom_measure(const EC_promInstance_t *Instances, uint16_t NumInstances, size_t *BufferSize,
+                     uint32_t *NumSlots);
+
+/**
+ * @brief Lays out the exposition text for a registry
+ *
+ * Writes all names, labels and comments once and renders the current values.
+ * Call again after changing the registry.
+ *
+ * @param[out] Exporter     Exporter to build
+ * @param[in]  Instances    Registry (must stay valid)
+ * @param[in]  NumInstances Number of registry entries
+ * @param[out] Buffer       Text buffer
+ * @param[in]  BufferSize   Size of Buffer
+ * @param[out] Slots        Value field table
+ * @param[in]  MaxSlots     Number of entries in Slots
+ *
+ * @return 0 on success, -1 if Buffer or Slots are too small (see EC_prom_measure())
+ */
+int EC_prom_build(EC_promExporter_t *Exporter, const EC_promInstance_t *Instances, uint16_t NumInstances,
+                  char *Buffer, size_t BufferSize, EC_promSlot_t *Slots, uint32_t MaxSlots);
+
+/**
+ * @brief Brings the text up to date for a scrape
+ *
+ * The layout of the statistics families is fixed at build time. If an
+ * instance registered or removed its statistics since then, its statistics
+ * series keep their previous values and Exporter->NeedsRebuild is set; call
+ * EC_prom_build() again to pick up the change.
+ *
+ * @param[in,out] Exporter Built exporter
+ * @return Length of the text in Exporter->Buffer
+ *
+ * @note Execution time: O(series), only changed fields are formatted
+ */
+size_t EC_prom_update(EC_promExporter_t *Exporter);
+
+#endif /* ERR_CORE_ERR_CORE_PROM_H_ */
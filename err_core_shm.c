@@ -0,0 +1,265 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "err_core_shm.h"
+#include "assert.h"
+#include "errno.h"
+#include "fcntl.h"
+#include "string.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#include "unistd.h"
+
+/** Orders the slot payload against its sequence counter across processes */
+#define EC_SHM_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/**
+ * Resets header and slots of a mapped segment, magic last.
+ */
+static void EC_shm_init(EC_shm_t *Shm, uint32_t Slots)
+{
+    for (uint32_t i = 0; i < Slots; i++)
+    {
+        EC_shmSlot_t *slot = &Shm->Slots[i];
+
+        // Under the seqlock - readers of a reused segment never copy a half-reset slot.
+        // An odd counter left by a crashed writer stays odd until the reset is done.
+        slot->Seq |= 1u;
+        EC_SHM_BARRIER();
+
+        // Generation keeps counting so a reader comparing it notices the reset
+        slot->Generation++;
+        slot->NumberOfErrors = 0;
+        memset(slot->Reserved, 0, sizeof(slot->Reserved));
+        slot->Tick = 0;
+        slot->ErrorReg = 0;
+        slot->WarningReg = 0;
+        memset(slot->WarningCnt, 0, sizeof(slot->WarningCnt));
+
+        EC_SHM_BARRIER();
+        slot->Seq++;
+    }
+
+    Shm->Header->Version = EC_SHM_VERSION;
+    Shm->Header->SlotSize = sizeof(EC_shmSlot_t);
+    Shm->Header->Slots = Slots;
+    Shm->Header->Reserved = 0;
+    EC_SHM_BARRIER();
+    // Magic last - readers attaching during creation reject the segment
+    Shm->Header->Magic = EC_SHM_MAGIC;
+}
+
+/**
+ * Creates the segment, or reuses an existing one of the same size, and maps it read-write.
+ */
+int EC_shm_create(EC_shm_t *Shm, const char *Name, uint32_t Slots)
+{
+    assert(Shm != NULL);
+    assert(Name != NULL);
+    assert(Slots > 0);
+
+    int fd = shm_open(Name, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    Shm->MapSize = sizeof(EC_shmHeader_t) + (size_t)Slots * sizeof(EC_shmSlot_t);
+
+    struct stat st;
+    if (0 != fstat(fd, &st))
+    {
+        close(fd);
+        return -1;
+    }
+
+    if ((0 != st.st_size) && ((size_t)st.st_size != Shm->MapSize))
+    {
+        // Resizing would fault readers still mapped to the old layout (SIGBUS past the end).
+        // Unlinking leaves them their mapping of the old object, the name gets a new one.
+        close(fd);
+        if ((0 != shm_unlink(Name)) && (ENOENT != errno))
+        {
+            return -1;
+        }
+        fd = shm_open(Name, O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (fd < 0)
+        {
+            return -1;
+        }
+        st.st_size = 0;
+    }
+
+    if ((0 == st.st_size) && (0 != ftruncate(fd, (off_t)Shm->MapSize)))
+    {
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, Shm->MapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map)
+    {
+        return -1;
+    }
+
+    Shm->Header = (EC_shmHeader_t *)map;
+    Shm->Slots = (EC_shmSlot_t *)((uint8_t *)map + sizeof(EC_shmHeader_t));
+
+    EC_shm_init(Shm, Slots);
+
+    return 0;
+}
+
+/**
+ * Maps an existing segment read-only.
+ */
+int EC_shm_attach(EC_shm_t *Shm, const char *Name)
+{
+    assert(Shm != NULL);
+    assert(Name != NULL);
+
+    int fd = shm_open(Name, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    EC_shmHeader_t header;
+    struct stat st;
+
+    if ((0 != fstat(fd, &st)) || ((size_t)st.st_size < sizeof(header)) ||
+        (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) || (EC_SHM_MAGIC != header.Magic) ||
+        (EC_SHM_VERSION != header.Version) || (sizeof(EC_shmSlot_t) != header.SlotSize) || (0 == header.Slots) ||
+        ((size_t)st.st_size < sizeof(header) + (size_t)header.Slots * sizeof(EC_shmSlot_t)))
+    {
+        close(fd);
+        errno = EPROTO;
+        return -1;
+    }
+
+    Shm->MapSize = sizeof(EC_shmHeader_t) + (size_t)header.Slots * sizeof(EC_shmSlot_t);
+
+    void *map = mmap(NULL, Shm->MapSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map)
+    {
+        return -1;
+    }
+
+    Shm->Header = (EC_shmHeader_t *)map;
+    Shm->Slots = (EC_shmSlot_t *)((uint8_t *)map + sizeof(EC_shmHeader_t));
+
+    return 0;
+}
+
+/**
+ * Unmaps the segment.
+ */
+void EC_shm_close(EC_shm_t *Shm)
+{
+    assert(Shm != NULL);
+
+    if (NULL != Shm->Header)
+    {
+        munmap(Shm->Header, Shm->MapSize);
+        Shm->Header = NULL;
+        Shm->Slots = NULL;
+    }
+}
+
+/**
+ * Removes the segment name.
+ */
+int EC_shm_unlink(const char *Name)
+{
+    assert(Name != NULL);
+
+    return shm_unlink(Name);
+}
+
+/**
+ * Publishes the state of an instance under the slot seqlock.
+ */
+void EC_shm_publish(EC_shm_t *Shm, uint32_t Slot, const EC_instance_t *Instance, EC_TIME_t Tick)
+{
+    assert(Shm != NULL);
+    assert(Shm->Slots != NULL);
+    assert(Slot < Shm->Header->Slots);
+    assert(Instance != NULL);
+
+    EC_shmSlot_t *slot = &Shm->Slots[Slot];
+    uint64_t error_reg = EC_publishedErrorReg(Instance);
+    uint64_t warning_reg = EC_publishedWarningReg(Instance);
+    uint8_t changed = (slot->ErrorReg != error_reg) || (slot->WarningReg != warning_reg) ||
+                      (slot->NumberOfErrors != Instance->NumberOfErrors);
+
+    for (uint8_t i = 0; !changed && (i < Instance->NumberOfErrors); i++)
+    {
+        changed = (slot->WarningCnt[i] != Instance->RuntimeData[i].WarningCnt);
+    }
+
+    slot->Seq++;
+    EC_SHM_BARRIER();
+
+    slot->Tick = (uint64_t)Tick;
+    if (changed)
+    {
+        slot->Generation++;
+        slot->NumberOfErrors = Instance->NumberOfErrors;
+        slot->ErrorReg = error_reg;
+        slot->WarningReg = warning_reg;
+        for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+        {
+            slot->WarningCnt[i] = Instance->RuntimeData[i].WarningCnt;
+        }
+    }
+
+    EC_SHM_BARRIER();
+    slot->Seq++;
+}
+
+/**
+ * Copies a slot, retrying while the writer is updating it.
+ */
+uint8_t EC_shm_read(const EC_shm_t *Shm, uint32_t Slot, EC_shmSlot_t *Out)
+{
+    assert(Shm != NULL);
+    assert(Shm->Slots != NULL);
+    assert(Slot < Shm->Header->Slots);
+    assert(Out != NULL);
+
+    const EC_shmSlot_t *slot = &Shm->Slots[Slot];
+
+    for (uint8_t attempt = 0; attempt < EC_SHM_READ_RETRIES; attempt++)
+    {
+        uint32_t seq = slot->Seq;
+        if (seq & 1u)
+        {
+            continue;
+        }
+        EC_SHM_BARRIER();
+
+        memcpy(Out, (const void *)slot, sizeof(*Out));
+
+        EC_SHM_BARRIER();
+        if (seq == slot->Seq)
+        {
+            Out->Seq = seq;
+            return 1;
+        }
+    }
+
+    return 0;
+}
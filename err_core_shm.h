@@ -0,0 +1,204 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file err_core_shm.h
+ * @brief Error Core - Shared-memory export for external monitors (Linux/POSIX)
+ *
+ * @details
+ * Publishes the state of one or more instances into a POSIX shared-memory
+ * segment. External processes (diagnostics UI, watchdog) map the segment
+ * read-only and take consistent snapshots without system calls and without
+ * any cooperation from the writer.
+ *
+ * Segment layout:
+ * - EC_shmHeader_t (magic, version, slot size, slot count)
+ * - Slots x EC_shmSlot_t, one per exported instance
+ *
+ * Every slot is guarded by its own sequence counter (seqlock): the writer
+ * makes it odd before and even after an update, a reader retries if the
+ * counter was odd or changed during the copy. The writer never waits.
+ *
+ * Generation increments whenever the exported state changes, Tick on every
+ * publish. A monitor compares Generation to detect changes and Tick to detect
+ * a stalled writer.
+ *
+ * @note One writer per slot. Link with -lrt on glibc older than 2.34.
+ *
+ * @example Writer (application)
+ * @code
+ * EC_shm_t shm;
+ * EC_shm_create(&shm, "/app_errors", 2);
+ *
+ * void main_loop(void) {
+ *     EC_poll(&motor);
+ *     EC_poll(&comm);
+ *     EC_shm_publish(&shm, 0, &motor, system_tick);
+ *     EC_shm_publish(&shm, 1, &comm, system_tick);
+ * }
+ * @endcode
+ *
+ * @example Reader (monitor process)
+ * @code
+ * EC_shm_t shm;
+ * EC_shmSlot_t slot;
+ *
+ * if (EC_shm_attach(&shm, "/app_errors") == 0 && EC_shm_read(&shm, 0, &slot)) {
+ *     printf("gen %llu errors 0x%016llx\n", slot.Generation, slot.ErrorReg);
+ * }
+ * @endcode
+ */
+
+#ifndef ERR_CORE_ERR_CORE_SHM_H_
+#define ERR_CORE_ERR_CORE_SHM_H_
+
+#include "err_core.h"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "err_core_shm requires a POSIX system with shm_open()"
+#endif
+
+/*******************************************************************************
+ * CONFIGURATION MACROS
+ ******************************************************************************/
+
+/** @brief Segment magic ("ECM1") */
+#define EC_SHM_MAGIC 0x314D4345u
+
+/** @brief Segment format version */
+#define EC_SHM_VERSION 1u
+
+/**
+ * @def EC_SHM_READ_RETRIES
+ * @brief Maximum attempts of EC_shm_read() before giving up
+ *
+ * @note Default: 8
+ */
+#ifndef EC_SHM_READ_RETRIES
+#define EC_SHM_READ_RETRIES 8
+#endif
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @struct EC_shmHeader_t
+ * @brief Segment header
+ */
+typedef struct
+{
+    uint32_t Magic;    /**< EC_SHM_MAGIC */
+    uint16_t Version;  /**< EC_SHM_VERSION */
+    uint16_t SlotSize; /**< sizeof(EC_shmSlot_t) */
+    uint32_t Slots;    /**< Number of slots */
+    uint32_t Reserved; /**< Zero */
+} EC_shmHeader_t;
+
+/**
+ * @struct EC_shmSlot_t
+ * @brief Exported state of one instance
+ */
+typedef struct
+{
+    volatile uint32_t Seq;   /**< Seqlock counter, odd while an update is in progress */
+    uint8_t NumberOfErrors;  /**< Number of valid entries in WarningCnt */
+    uint8_t Reserved[3];     /**< Zero */
+    uint64_t Generation;     /**< Incremented whenever the state below changes */
+    uint64_t Tick;           /**< Tick of the last publish (heartbeat) */
+    uint64_t ErrorReg;       /**< Registered errors */
+    uint64_t WarningReg;     /**< Active warnings */
+    uint8_t WarningCnt[64];  /**< Warning counters per error */
+} EC_shmSlot_t;
+
+/**
+ * @struct EC_shm_t
+ * @brief Mapped segment, writer or reader side
+ */
+typedef struct
+{
+    EC_shmHeader_t *Header; /**< Mapped header */
+    EC_shmSlot_t *Slots;    /**< Mapped slots */
+    size_t MapSize;         /**< Size of the mapping in bytes */
+} EC_shm_t;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief Creates (or recreates) a segment and maps it for writing
+ *
+ * An existing segment of the same size is reused in place: every slot is
+ * reset under its seqlock, so attached readers keep working and see a new
+ * Generation with empty registers. A segment of a different size is
+ * unlinked and replaced; readers still mapped to it keep the old, no longer
+ * updated object (Tick stops) and have to re-attach.
+ *
+ * @param[out] Shm   Segment to create
+ * @param[in]  Name  POSIX shared-memory name (e.g. "/app_errors")
+ * @param[in]  Slots Number of instance slots (>= 1)
+ *
+ * @return 0 on success, -1 on failure (errno is set)
+ */
+int EC_shm_create(EC_shm_t *Shm, const char *Name, uint32_t Slots);
+
+/**
+ * @brief Maps an existing segment read-only
+ *
+ * @param[out] Shm  Segment to attach
+ * @param[in]  Name POSIX shared-memory name
+ *
+ * @return 0 on success, -1 on failure (errno is set, EPROTO for an incompatible segment)
+ */
+int EC_shm_attach(EC_shm_t *Shm, const char *Name);
+
+/**
+ * @brief Unmaps the segment
+ *
+ * The segment itself persists until EC_shm_unlink().
+ */
+void EC_shm_close(EC_shm_t *Shm);
+
+/**
+ * @brief Removes the segment name
+ *
+ * @return 0 on success, -1 on failure (errno is set)
+ */
+int EC_shm_unlink(const char *Name);
+
+/**
+ * @brief Publishes the state of an instance into a slot
+ *
+ * Call after EC_poll(). Only the owning thread of the instance may publish.
+ *
+ * @param[in,out] Shm      Segment created with EC_shm_create()
+ * @param[in]     Slot     Slot index
+ * @param[in]     Instance Instance to export
+ * @param[in]     Tick     Current tick (heartbeat)
+ *
+ * @note Execution time: O(n), no system calls
+ */
+void EC_shm_publish(EC_shm_t *Shm, uint32_t Slot, const EC_instance_t *Instance, EC_TIME_t Tick);
+
+/**
+ * @brief Takes a consistent copy of a slot
+ *
+ * @param[in]  Shm  Attached or created segment
+ * @param[in]  Slot Slot index
+ * @param[out] Out  Copy of the slot
+ *
+ * @return 1 on success, 0 if the writer kept updating for EC_SHM_READ_RETRIES attempts
+ *
+ * @note No system calls, never blocks the writer
+ */
+uint8_t EC_shm_read(const EC_shm_t *Shm, uint32_t Slot, EC_shmSlot_t *Out);
+
+#endif /* ERR_CORE_ERR_CORE_SHM_H_ */
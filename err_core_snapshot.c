@@ -0,0 +1,199 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#include "err_core_snapshot.h"
+#include "assert.h"
+
+#define EC_SNAPSHOT_HEADER_SIZE 28u
+#define EC_FNV_OFFSET 2166136261u
+#define EC_FNV_PRIME 16777619u
+
+/**
+ * Feeds Size little-endian bytes of Value into an FNV-1a hash.
+ */
+static uint32_t EC_snapshot_hash(uint32_t Hash, uint64_t Value, uint8_t Size)
+{
+    for (uint8_t i = 0; i < Size; i++)
+    {
+        Hash ^= (uint8_t)(Value >> (8u * i));
+        Hash *= EC_FNV_PRIME;
+    }
+
+    return Hash;
+}
+
+/**
+ * FNV-1a over a byte buffer.
+ */
+static uint32_t EC_snapshot_checksum(const uint8_t *Data, size_t Size)
+{
+    uint32_t hash = EC_FNV_OFFSET;
+
+    for (size_t i = 0; i < Size; i++)
+    {
+        hash ^= Data[i];
+        hash *= EC_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static void EC_snapshot_put(uint8_t *Out, uint64_t Value, uint8_t Size)
+{
+    for (uint8_t i = 0; i < Size; i++)
+    {
+        Out[i] = (uint8_t)(Value >> (8u * i));
+    }
+}
+
+static uint64_t EC_snapshot_get(const uint8_t *In, uint8_t Size)
+{
+    uint64_t value = 0;
+
+    for (uint8_t i = 0; i < Size; i++)
+    {
+        value |= (uint64_t)In[i] << (8u * i);
+    }
+
+    return value;
+}
+
+/**
+ * Computes the configuration fingerprint.
+ */
+uint32_t EC_snapshot_fingerprint(const EC_instance_t *Instance)
+{
+    assert(Instance != NULL);
+    assert(Instance->Errors != NULL);
+
+    uint32_t hash = EC_snapshot_hash(EC_FNV_OFFSET, Instance->NumberOfErrors, 1);
+
+    for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+    {
+        const EC_error_t *error = &Instance->Errors[i];
+
+        hash = EC_snapshot_hash(hash, error->HelperNumber, 2);
+        hash = EC_snapshot_hash(hash, (uint64_t)error->TimeToErrorRegister, sizeof(EC_TIME_t));
+        hash = EC_snapshot_hash(hash, (uint64_t)error->TimeToResetWarning, sizeof(EC_TIME_t));
+        hash = EC_snapshot_hash(hash, error->WarningsToError, 2);
+#if EC_USE_SEVERITY
+        hash = EC_snapshot_hash(hash, error->Severity, 1);
+#endif
+        hash = EC_snapshot_hash(hash, (NULL != error->ErrFunc) ? 1u : 0u, 1);
+    }
+
+    return hash;
+}
+
+/**
+ * Saves the runtime state into Buffer.
+ */
+size_t EC_snapshot_save(const EC_instance_t *Instance, EC_TIME_t Tick, uint8_t *Buffer, size_t Size)
+{
+    assert(Instance != NULL);
+    assert(Buffer != NULL);
+
+    size_t image_size = EC_SNAPSHOT_SIZE(Instance->NumberOfErrors);
+    if (Size < image_size)
+    {
+        return 0;
+    }
+
+    Buffer[0] = 'E';
+    Buffer[1] = 'C';
+    Buffer[2] = 'S';
+    Buffer[3] = EC_SNAPSHOT_VERSION;
+    Buffer[4] = Instance->NumberOfErrors;
+    Buffer[5] = sizeof(EC_TIME_t);
+    Buffer[6] = 0;
+    Buffer[7] = 0;
+    EC_snapshot_put(&Buffer[8], EC_snapshot_fingerprint(Instance), 4);
+    EC_snapshot_put(&Buffer[12], Instance->ErrorReg, 8);
+    EC_snapshot_put(&Buffer[20], Instance->WarningReg, 8);
+
+    uint8_t *out = &Buffer[EC_SNAPSHOT_HEADER_SIZE];
+    for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+    {
+        const EC_runtimeData_t *runtime = &Instance->RuntimeData[i];
+
+        // Ages instead of absolute ticks - rebased onto the new tick origin at restore
+        EC_snapshot_put(out, (uint64_t)(EC_TIME_t)(Tick - runtime->LastReg), sizeof(EC_TIME_t));
+        out += sizeof(EC_TIME_t);
+        EC_snapshot_put(out, (uint64_t)(EC_TIME_t)(Tick - runtime->LastNoErr), sizeof(EC_TIME_t));
+        out += sizeof(EC_TIME_t);
+        *out++ = (uint8_t)(runtime->WarningCnt | (runtime->WarningPending << 7));
+    }
+
+    EC_snapshot_put(out, EC_snapshot_checksum(Buffer, (size_t)(out - Buffer)), 4);
+
+    return image_size;
+}
+
+/**
+ * Validates the image and restores the runtime state.
+ */
+EC_snapshot_status_t EC_snapshot_restore(EC_instance_t *Instance, EC_TIME_t Tick, const uint8_t *Buffer,
+                                         size_t Size)
+{
+    assert(Instance != NULL);
+    assert(Buffer != NULL);
+
+    if (Size < EC_SNAPSHOT_HEADER_SIZE + 4u)
+    {
+        return EC_SNAPSHOT_TOO_SHORT;
+    }
+    if (('E' != Buffer[0]) || ('C' != Buffer[1]) || ('S' != Buffer[2]) || (EC_SNAPSHOT_VERSION != Buffer[3]))
+    {
+        return EC_SNAPSHOT_BAD_FORMAT;
+    }
+    if ((Buffer[4] != Instance->NumberOfErrors) || (Buffer[5] != sizeof(EC_TIME_t)))
+    {
+        return EC_SNAPSHOT_MISMATCH;
+    }
+
+    size_t image_size = EC_SNAPSHOT_SIZE(Instance->NumberOfErrors);
+    if (Size < image_size)
+    {
+        return EC_SNAPSHOT_TOO_SHORT;
+    }
+    if (EC_snapshot_get(&Buffer[image_size - 4u], 4) != EC_snapshot_checksum(Buffer, image_size - 4u))
+    {
+        return EC_SNAPSHOT_BAD_FORMAT;
+    }
+    if (EC_snapshot_get(&Buffer[8], 4) != EC_snapshot_fingerprint(Instance))
+    {
+        return EC_SNAPSHOT_MISMATCH;
+    }
+
+    uint64_t valid = EC_ALL_ERRORS_MASK(Instance->NumberOfErrors);
+    Instance->ErrorReg = EC_snapshot_get(&Buffer[12], 8) & valid;
+    Instance->WarningReg = EC_snapshot_get(&Buffer[20], 8) & valid;
+
+    const uint8_t *in = &Buffer[EC_SNAPSHOT_HEADER_SIZE];
+    for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+    {
+        EC_runtimeData_t *runtime = &Instance->RuntimeData[i];
+
+        runtime->LastReg = (EC_TIME_t)(Tick - (EC_TIME_t)EC_snapshot_get(in, sizeof(EC_TIME_t)));
+        in += sizeof(EC_TIME_t);
+        runtime->LastNoErr = (EC_TIME_t)(Tick - (EC_TIME_t)EC_snapshot_get(in, sizeof(EC_TIME_t)));
+        in += sizeof(EC_TIME_t);
+        runtime->WarningCnt = *in & 0x7Fu;
+        runtime->WarningPending = (*in >> 7) & 1u;
+        in++;
+    }
+
+    // No transitions are emitted - consumers attached later seed from the restored registers
+#if EC_USE_HIERARCHY
+    EC_updateSummary(Instance);
+#endif
+
+    return EC_SNAPSHOT_OK;
+}
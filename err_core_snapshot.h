@@ -0,0 +1,153 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file err_core_snapshot.h
+ * @brief Error Core - Warm restart snapshot and restore
+ *
+ * @details
+ * Saves the runtime state of an instance (ErrorReg, WarningReg and every
+ * EC_runtimeData_t) into a compact, versioned binary image and restores it
+ * after a software update or process restart. Persistent faults then keep
+ * their debounce progress and accumulated WarningCnt instead of starting
+ * from zero.
+ *
+ * Timestamps are stored as ages relative to the tick at save time and
+ * rebased onto the tick at restore time, so the new process may use a
+ * different tick origin. Time spent while the system was down is not counted.
+ *
+ * The image carries a fingerprint of the EC_error_t table (timing, thresholds,
+ * helper numbers). Restoring into an instance with a different configuration
+ * is rejected.
+ *
+ * A restore overwrites the registers without emitting transitions. Restore
+ * right after EC_init() and attach transition consumers (statistics, notify,
+ * log, journal, history) afterwards, so they start from the restored state.
+ * The parent summaries (EC_USE_HIERARCHY) are updated by the restore.
+ *
+ * Image layout (little-endian):
+ * | Field                      | Size                       |
+ * |----------------------------|----------------------------|
+ * | Magic "ECS" + version      | 4                          |
+ * | NumberOfErrors, tick width | 2                          |
+ * | Reserved                   | 2                          |
+ * | Config fingerprint         | 4                          |
+ * | ErrorReg, WarningReg       | 16                         |
+ * | Per error: LastReg age, LastNoErr age, WarningCnt/WarningPending | 2 * sizeof(EC_TIME_t) + 1 |
+ * | Checksum (FNV-1a)          | 4                          |
+ *
+ * @example Shutdown hook and startup
+ * @code
+ * uint8_t image[EC_SNAPSHOT_SIZE(NUM_ERRORS)];
+ *
+ * void on_shutdown(void) {
+ *     size_t len = EC_snapshot_save(&instance, system_tick, image, sizeof(image));
+ *     persist(image, len);
+ * }
+ *
+ * void on_startup(void) {
+ *     EC_init(&instance, errors, runtime, NUM_ERRORS);
+ *     if (load(image, sizeof(image)) &&
+ *         EC_snapshot_restore(&instance, system_tick, image, sizeof(image)) != EC_SNAPSHOT_OK) {
+ *         // Stale or foreign image - start fresh
+ *     }
+ *     // Consumers seed from the restored registers
+ *     EC_log_init(&writer, block, sizeof(block), write_block, log_file, &instance, system_tick);
+ *     EC_log_attach(&writer, &instance);
+ * }
+ * @endcode
+ */
+
+#ifndef ERR_CORE_ERR_CORE_SNAPSHOT_H_
+#define ERR_CORE_ERR_CORE_SNAPSHOT_H_
+
+#include "err_core.h"
+
+/*******************************************************************************
+ * CONFIGURATION MACROS
+ ******************************************************************************/
+
+/** @brief Snapshot format version */
+#define EC_SNAPSHOT_VERSION 1u
+
+/** @brief Image size in bytes for an instance with n errors */
+#define EC_SNAPSHOT_SIZE(n) (32u + (size_t)(n) * (2u * sizeof(EC_TIME_t) + 1u))
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @enum EC_snapshot_status_t
+ * @brief Result of EC_snapshot_restore()
+ */
+typedef enum
+{
+    EC_SNAPSHOT_OK = 0,         /**< State restored */
+    EC_SNAPSHOT_TOO_SHORT = 1,  /**< Buffer smaller than the image */
+    EC_SNAPSHOT_BAD_FORMAT = 2, /**< Wrong magic, version or checksum */
+    EC_SNAPSHOT_MISMATCH = 3    /**< Different error table or tick width */
+} EC_snapshot_status_t;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief Computes the configuration fingerprint of an instance
+ *
+ * FNV-1a over NumberOfErrors and, per error, HelperNumber,
+ * TimeToErrorRegister, TimeToResetWarning, WarningsToError, Severity (when
+ * enabled) and whether ErrFunc is set. Function addresses are not included,
+ * so the fingerprint survives a rebuild.
+ *
+ * @param[in] Instance Pointer to initialized instance
+ * @return 32-bit fingerprint
+ */
+uint32_t EC_snapshot_fingerprint(const EC_instance_t *Instance);
+
+/**
+ * @brief Saves the runtime state of an instance
+ *
+ * @param[in]  Instance Pointer to initialized instance
+ * @param[in]  Tick     Current tick (timestamps are stored relative to it)
+ * @param[out] Buffer   Output buffer
+ * @param[in]  Size     Size of Buffer (>= EC_SNAPSHOT_SIZE(NumberOfErrors))
+ *
+ * @return Number of bytes written, 0 if Buffer is too small
+ *
+ * @note Execution time: O(n), no allocation - suitable for shutdown hooks
+ */
+size_t EC_snapshot_save(const EC_instance_t *Instance, EC_TIME_t Tick, uint8_t *Buffer, size_t Size);
+
+/**
+ * @brief Restores the runtime state of an instance
+ *
+ * The image is fully validated before anything is written; on error the
+ * instance is left untouched.
+ *
+ * No transitions are emitted for the restored errors and warnings, and
+ * EC_stats_t periods are not opened for them. Call it before attaching
+ * transition consumers; consumers attached earlier must be re-seeded from
+ * the instance afterwards (e.g. EC_log_init(), EC_history_init()). With
+ * EC_USE_HIERARCHY the summaries of the instance and its parents are
+ * updated.
+ *
+ * @param[in,out] Instance Pointer to initialized instance (same error table as at save)
+ * @param[in]     Tick     Current tick (timestamps are rebased onto it)
+ * @param[in]     Buffer   Image produced by EC_snapshot_save()
+ * @param[in]     Size     Size of Buffer
+ *
+ * @return EC_SNAPSHOT_OK on success, error code otherwise
+ */
+EC_snapshot_status_t EC_snapshot_restore(EC_instance_t *Instance, EC_TIME_t Tick, const uint8_t *Buffer,
+                                         size_t Size);
+
+#endif /* ERR_CORE_ERR_CORE_SNAPSHOT_H_ */
@@ -0,0 +1,425 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#include "err_core_telemetry.h"
+#include "assert.h"
+#include "string.h"
+
+#define EC_TELEMETRY_KEYFRAME 0u
+#define EC_TELEMETRY_SPARSE 1u
+#define EC_TELEMETRY_MASK 2u
+#define EC_TELEMETRY_HEADER_SIZE 3u
+
+/**
+ * CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), bitwise to keep the table out of flash.
+ */
+static uint16_t EC_telemetry_crc(const uint8_t *Data, size_t Size)
+{
+    uint16_t crc = 0xFFFFu;
+
+    for (size_t i = 0; i < Size; i++)
+    {
+        crc ^= (uint16_t)((uint16_t)Data[i] << 8);
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * Number of bytes used to send a register of NumberOfErrors bits.
+ */
+static uint8_t EC_telemetry_regBytes(uint8_t NumberOfErrors)
+{
+    return (uint8_t)((NumberOfErrors + 7u) / 8u);
+}
+
+static void EC_telemetry_putReg(uint8_t *Out, uint64_t Value, uint8_t Bytes)
+{
+    for (uint8_t i = 0; i < Bytes; i++)
+    {
+        Out[i] = (uint8_t)(Value >> (8u * i));
+    }
+}
+
+static uint64_t EC_telemetry_getReg(const uint8_t *In, uint8_t Bytes)
+{
+    uint64_t value = 0;
+
+    for (uint8_t i = 0; i < Bytes; i++)
+    {
+        value |= (uint64_t)In[i] << (8u * i);
+    }
+
+    return value;
+}
+
+/**
+ * COBS-encodes Size bytes of Raw into Out and appends the 0x00 delimiter.
+ * Returns the number of bytes written.
+ */
+static size_t EC_telemetry_cobs(const uint8_t *Raw, size_t Size, uint8_t *Out)
+{
+    size_t code_pos = 0;
+    size_t out = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < Size; i++)
+    {
+        if (0 == Raw[i])
+        {
+            Out[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        }
+        else
+        {
+            Out[out++] = Raw[i];
+            code++;
+            // Raw frames are shorter than 254 bytes, so a full block never occurs
+        }
+    }
+    Out[code_pos] = code;
+    Out[out++] = 0;
+
+    return out;
+}
+
+/**
+ * Initializes an encoder.
+ */
+void EC_telemetry_encoder_init(EC_telemetryEncoder_t *Encoder, uint8_t Source, uint16_t KeyframeInterval)
+{
+    assert(Encoder != NULL);
+
+    memset(Encoder, 0, sizeof(*Encoder));
+    Encoder->Source = Source;
+    Encoder->KeyframeInterval = KeyframeInterval;
+    Encoder->KeyframeDue = 1;
+}
+
+/**
+ * Forces a keyframe on the next encode.
+ */
+void EC_telemetry_request_keyframe(EC_telemetryEncoder_t *Encoder)
+{
+    assert(Encoder != NULL);
+
+    Encoder->KeyframeDue = 1;
+}
+
+/**
+ * Encodes a keyframe or the smallest delta and frames it.
+ */
+size_t EC_telemetry_encode(EC_telemetryEncoder_t *Encoder, const EC_instance_t *Instance, uint8_t *Out,
+                           size_t Size)
+{
+    assert(Encoder != NULL);
+    assert(Instance != NULL);
+    assert(Out != NULL);
+    assert(Size >= EC_TELEMETRY_MAX_FRAME);
+    (void)Size;
+
+    uint8_t raw[EC_TELEMETRY_MAX_RAW];
+    uint8_t len = EC_TELEMETRY_HEADER_SIZE;
+    uint8_t bytes = EC_telemetry_regBytes(Instance->NumberOfErrors);
+    uint64_t error_reg = EC_publishedErrorReg(Instance);
+    uint64_t warning_reg = EC_publishedWarningReg(Instance);
+    uint64_t error_xor = error_reg ^ Encoder->ErrorReg;
+    uint64_t warning_xor = warning_reg ^ Encoder->WarningReg;
+    uint8_t type;
+
+    if (Encoder->KeyframeInterval && (++Encoder->SinceKeyframe >= Encoder->KeyframeInterval))
+    {
+        Encoder->KeyframeDue = 1;
+    }
+
+    if (Encoder->KeyframeDue)
+    {
+        type = EC_TELEMETRY_KEYFRAME;
+        raw[len++] = Instance->NumberOfErrors;
+        EC_telemetry_putReg(&raw[len], error_reg, bytes);
+        len = (uint8_t)(len + bytes);
+        EC_telemetry_putReg(&raw[len], warning_reg, bytes);
+        len = (uint8_t)(len + bytes);
+        Encoder->KeyframeDue = 0;
+        Encoder->SinceKeyframe = 0;
+    }
+    else if ((0 == error_xor) && (0 == warning_xor))
+    {
+        return 0;
+    }
+    else
+    {
+        uint8_t flipped = 0;
+        uint64_t bits = error_xor;
+        while (bits && (1u + flipped < 2u * bytes))
+        {
+            bits &= bits - 1u;
+            flipped++;
+        }
+        bits = warning_xor;
+        while (bits && (1u + flipped < 2u * bytes))
+        {
+            bits &= bits - 1u;
+            flipped++;
+        }
+
+        if (1u + flipped < 2u * bytes)
+        {
+            // Sparse: one byte per flipped bit, register in the top bits
+            type = EC_TELEMETRY_SPARSE;
+            raw[len++] = flipped;
+            for (bits = error_xor; bits; bits &= bits - 1u)
+            {
+                raw[len++] = EC_lowestBit(bits);
+            }
+            for (bits = warning_xor; bits; bits &= bits - 1u)
+            {
+                raw[len++] = (uint8_t)(0x40u | EC_lowestBit(bits));
+            }
+        }
+        else
+        {
+            type = EC_TELEMETRY_MASK;
+            EC_telemetry_putReg(&raw[len], error_xor, bytes);
+            len = (uint8_t)(len + bytes);
+            EC_telemetry_putReg(&raw[len], warning_xor, bytes);
+            len = (uint8_t)(len + bytes);
+        }
+    }
+
+    raw[0] = (uint8_t)((EC_TELEMETRY_VERSION << 4) | type);
+    raw[1] = Encoder->Source;
+    raw[2] = Encoder->Seq++;
+
+    uint16_t crc = EC_telemetry_crc(raw, len);
+    raw[len++] = (uint8_t)crc;
+    raw[len++] = (uint8_t)(crc >> 8);
+
+    Encoder->ErrorReg = error_reg;
+    Encoder->WarningReg = warning_reg;
+
+    return EC_telemetry_cobs(raw, len, Out);
+}
+
+/**
+ * Initializes a streaming decoder.
+ */
+void EC_telemetry_decoder_init(EC_telemetryDecoder_t *Decoder, EC_telemetrySource_t *Sources, uint16_t NumSources,
+                               void (*OnFrame)(void *Context, const EC_telemetryFrame_t *Frame), void *Context)
+{
+    assert(Decoder != NULL);
+    assert((Sources != NULL) || (0 == NumSources));
+
+    memset(Decoder, 0, sizeof(*Decoder));
+    memset(Sources, 0, (size_t)NumSources * sizeof(EC_telemetrySource_t));
+    Decoder->Sources = Sources;
+    Decoder->NumSources = NumSources;
+    Decoder->OnFrame = OnFrame;
+    Decoder->Context = Context;
+}
+
+/**
+ * Decodes COBS in place. Returns the decoded length, 0 if invalid.
+ */
+static uint8_t EC_telemetry_uncobs(uint8_t *Data, uint8_t Size)
+{
+    uint8_t in = 0;
+    uint8_t out = 0;
+
+    while (in < Size)
+    {
+        uint8_t code = Data[in++];
+        if ((0 == code) || ((uint16_t)in + code - 1u > Size))
+        {
+            return 0;
+        }
+        for (uint8_t i = 1; i < code; i++)
+        {
+            Data[out++] = Data[in++];
+        }
+        if ((code < 0xFFu) && (in < Size))
+        {
+            Data[out++] = 0;
+        }
+    }
+
+    return out;
+}
+
+/**
+ * Validates and applies one unframed frame.
+ */
+static void EC_telemetry_apply(EC_telemetryDecoder_t *Decoder, const uint8_t *Raw, uint8_t Size)
+{
+    if ((Size < EC_TELEMETRY_HEADER_SIZE + 2u) ||
+        (EC_telemetry_getReg(&Raw[Size - 2u], 2) != EC_telemetry_crc(Raw, Size - 2u)) ||
+        ((Raw[0] >> 4) != EC_TELEMETRY_VERSION) || (Raw[1] >= Decoder->NumSources))
+    {
+        Decoder->Corrupt++;
+        return;
+    }
+
+    EC_telemetrySource_t *source = &Decoder->Sources[Raw[1]];
+    const uint8_t *payload = &Raw[EC_TELEMETRY_HEADER_SIZE];
+    uint8_t payload_len = (uint8_t)(Size - EC_TELEMETRY_HEADER_SIZE - 2u);
+    uint8_t type = Raw[0] & 0x0Fu;
+    uint8_t seq = Raw[2];
+    uint64_t error_xor = 0;
+    uint64_t warning_xor = 0;
+
+    if (source->Synced && (seq != source->NextSeq))
+    {
+        Decoder->Lost += (uint8_t)(seq - source->NextSeq);
+        source->Synced = 0;
+    }
+
+    switch (type)
+    {
+    case EC_TELEMETRY_KEYFRAME: {
+        uint8_t bytes = (payload_len > 0) ? EC_telemetry_regBytes(payload[0]) : 0;
+        if ((0 == payload_len) || (payload[0] > 64) || (payload_len != 1u + 2u * bytes))
+        {
+            Decoder->Corrupt++;
+            return;
+        }
+        uint64_t error_reg = EC_telemetry_getReg(&payload[1], bytes);
+        uint64_t warning_reg = EC_telemetry_getReg(&payload[1 + bytes], bytes);
+        error_xor = source->Synced ? (error_reg ^ source->ErrorReg) : error_reg;
+        warning_xor = source->Synced ? (warning_reg ^ source->WarningReg) : warning_reg;
+        source->ErrorReg = error_reg;
+        source->WarningReg = warning_reg;
+        source->NumberOfErrors = payload[0];
+        source->Synced = 1;
+        break;
+    }
+
+    case EC_TELEMETRY_SPARSE:
+        if ((0 == payload_len) || (payload_len != 1u + payload[0]))
+        {
+            Decoder->Corrupt++;
+            return;
+        }
+        for (uint8_t i = 1; i < payload_len; i++)
+        {
+            if ((payload[i] & 0x3Fu) >= source->NumberOfErrors && source->Synced)
+            {
+                Decoder->Corrupt++;
+                return;
+            }
+            uint64_t bit = (uint64_t)1 << (payload[i] & 0x3Fu);
+            if (payload[i] & 0x40u)
+            {
+                warning_xor ^= bit;
+            }
+            else
+            {
+                error_xor ^= bit;
+            }
+        }
+        break;
+
+    case EC_TELEMETRY_MASK: {
+        uint8_t bytes = EC_telemetry_regBytes(source->NumberOfErrors);
+        if (source->Synced && (payload_len != 2u * bytes))
+        {
+            Decoder->Corrupt++;
+            return;
+        }
+        error_xor = EC_telemetry_getReg(payload, bytes);
+        warning_xor = EC_telemetry_getReg(&payload[bytes], bytes);
+        break;
+    }
+
+    default:
+        Decoder->Corrupt++;
+        return;
+    }
+
+    source->NextSeq = (uint8_t)(seq + 1u);
+
+    if (!source->Synced)
+    {
+        // Delta against an unknown base - wait for the next keyframe
+        Decoder->Unsynced++;
+        return;
+    }
+
+    if (EC_TELEMETRY_KEYFRAME != type)
+    {
+        source->ErrorReg ^= error_xor;
+        source->WarningReg ^= warning_xor;
+    }
+    Decoder->Frames++;
+
+    if (NULL != Decoder->OnFrame)
+    {
+        EC_telemetryFrame_t frame = {
+            .ErrorReg = source->ErrorReg,
+            .WarningReg = source->WarningReg,
+            .ErrorChanged = error_xor,
+            .WarningChanged = warning_xor,
+            .NumberOfErrors = source->NumberOfErrors,
+            .Source = Raw[1],
+            .Seq = seq,
+            .Keyframe = (EC_TELEMETRY_KEYFRAME == type),
+        };
+        Decoder->OnFrame(Decoder->Context, &frame);
+    }
+}
+
+/**
+ * Splits the byte stream at 0x00 delimiters and decodes every frame.
+ */
+void EC_telemetry_decoder_feed(EC_telemetryDecoder_t *Decoder, const uint8_t *Data, size_t Size)
+{
+    assert(Decoder != NULL);
+    assert((Data != NULL) || (0 == Size));
+
+    for (size_t i = 0; i < Size; i++)
+    {
+        if (0 != Data[i])
+        {
+            if (Decoder->Length < EC_TELEMETRY_MAX_FRAME)
+            {
+                Decoder->Buffer[Decoder->Length++] = Data[i];
+            }
+            else
+            {
+                Decoder->Overflow = 1;
+            }
+            continue;
+        }
+
+        if (Decoder->Overflow)
+        {
+            Decoder->Corrupt++;
+        }
+        else if (Decoder->Length > 0)
+        {
+            uint8_t len = EC_telemetry_uncobs(Decoder->Buffer, Decoder->Length);
+            if (len)
+            {
+                EC_telemetry_apply(Decoder, Decoder->Buffer, len);
+            }
+            else
+            {
+                Decoder->Corrupt++;
+            }
+        }
+
+        Decoder->Length = 0;
+        Decoder->Overflow = 0;
+    }
+}
@@ -0,0 +1,213 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file err_core_telemetry.h
+ * @brief Error Core - Delta telemetry frames for constrained links
+ *
+ * @details
+ * Encodes the register state of an instance into small frames for serial or
+ * radio links and decodes them on the other side. Instead of resending both
+ * 8-byte registers every period, only the changed bits are sent:
+ *
+ * | Type      | Payload                                        | Used when                    |
+ * |-----------|------------------------------------------------|------------------------------|
+ * | Keyframe  | NumberOfErrors, ErrorReg, WarningReg           | first frame and periodically |
+ * | Sparse    | count, then one byte per flipped bit (reg<<6 or index) | few bits changed     |
+ * | Mask      | ErrorReg XOR, WarningReg XOR                   | many bits changed            |
+ *
+ * Registers are sent as ceil(NumberOfErrors / 8) little-endian bytes.
+ *
+ * Frame layout before framing:
+ * | Header (version << 4 or type) | Source | Sequence | Payload | CRC-16/CCITT |
+ *
+ * Every frame is COBS-encoded and terminated with 0x00, so it can be sent
+ * over any byte stream and the decoder resynchronizes on the next delimiter
+ * after noise. Deltas are relative to the previous frame of the same source;
+ * after a sequence gap the decoder drops deltas of that source until the next
+ * keyframe.
+ *
+ * The module is freestanding C (no allocation, no OS calls) and builds for
+ * both the embedded encoder side and the host decoder side.
+ *
+ * @example Device side
+ * @code
+ * EC_telemetryEncoder_t enc;
+ * EC_telemetry_encoder_init(&enc, 0, 50);   // source 0, keyframe every 50 periods
+ *
+ * void every_100ms(void) {
+ *     uint8_t frame[EC_TELEMETRY_MAX_FRAME];
+ *     size_t len = EC_telemetry_encode(&enc, &instance, frame, sizeof(frame));
+ *     if (len) uart_write(frame, len);
+ * }
+ * @endcode
+ *
+ * @example Host side
+ * @code
+ * void on_frame(void *ctx, const EC_telemetryFrame_t *f) {
+ *     printf("src %u errors 0x%llx\n", f->Source, (unsigned long long)f->ErrorReg);
+ * }
+ *
+ * EC_telemetrySource_t sources[4];
+ * EC_telemetryDecoder_t dec;
+ * EC_telemetry_decoder_init(&dec, sources, 4, on_frame, NULL);
+ * while ((n = read(fd, buf, sizeof(buf))) > 0) {
+ *     EC_telemetry_decoder_feed(&dec, buf, n);
+ * }
+ * @endcode
+ */
+
+#ifndef ERR_CORE_ERR_CORE_TELEMETRY_H_
+#define ERR_CORE_ERR_CORE_TELEMETRY_H_
+
+#include "err_core.h"
+
+/*******************************************************************************
+ * CONFIGURATION MACROS
+ ******************************************************************************/
+
+/** @brief Telemetry format version stored in every header */
+#define EC_TELEMETRY_VERSION 1u
+
+/** @brief Longest unframed frame (keyframe: 3 header + 1 + 2 * 8 + 2 CRC) */
+#define EC_TELEMETRY_MAX_RAW 22u
+
+/** @brief Longest framed frame (COBS overhead + delimiter) */
+#define EC_TELEMETRY_MAX_FRAME (EC_TELEMETRY_MAX_RAW + 2u)
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @struct EC_telemetryEncoder_t
+ * @brief Encoder state of one source
+ */
+typedef struct
+{
+    uint64_t ErrorReg;          /**< Published ErrorReg as of the last frame sent */
+    uint64_t WarningReg;        /**< WarningReg as of the last frame sent */
+    uint16_t KeyframeInterval;  /**< Periods between keyframes (0 = only the first) */
+    uint16_t SinceKeyframe;     /**< Periods since the last keyframe */
+    uint8_t Source;             /**< Source id written to every frame */
+    uint8_t Seq;                /**< Sequence number of the next frame */
+    uint8_t KeyframeDue;        /**< Next frame is a keyframe */
+} EC_telemetryEncoder_t;
+
+/**
+ * @struct EC_telemetrySource_t
+ * @brief Decoder state of one source
+ */
+typedef struct
+{
+    uint64_t ErrorReg;      /**< Decoded error register */
+    uint64_t WarningReg;    /**< Decoded warning register */
+    uint8_t NumberOfErrors; /**< From the last keyframe */
+    uint8_t NextSeq;        /**< Expected sequence number */
+    uint8_t Synced;         /**< Set after a keyframe, cleared on a sequence gap */
+} EC_telemetrySource_t;
+
+/**
+ * @struct EC_telemetryFrame_t
+ * @brief Decoded frame passed to the decoder callback
+ */
+typedef struct
+{
+    uint64_t ErrorReg;       /**< Error register after this frame */
+    uint64_t WarningReg;     /**< Warning register after this frame */
+    uint64_t ErrorChanged;   /**< Bits of ErrorReg changed by this frame */
+    uint64_t WarningChanged; /**< Bits of WarningReg changed by this frame */
+    uint8_t NumberOfErrors;  /**< Number of errors of the source */
+    uint8_t Source;          /**< Source id */
+    uint8_t Seq;             /**< Sequence number */
+    uint8_t Keyframe;        /**< 1 for keyframes, 0 for deltas */
+} EC_telemetryFrame_t;
+
+/**
+ * @struct EC_telemetryDecoder_t
+ * @brief Streaming decoder state
+ */
+typedef struct
+{
+    EC_telemetrySource_t *Sources; /**< Per-source state, indexed by source id */
+    uint16_t NumSources;           /**< Number of entries in Sources */
+
+    void (*OnFrame)(void *Context, const EC_telemetryFrame_t *Frame); /**< Frame callback */
+    void *Context;                                                    /**< User pointer passed to OnFrame */
+
+    uint32_t Frames;   /**< Frames applied */
+    uint32_t Corrupt;  /**< Frames dropped: COBS, CRC, format or unknown source */
+    uint32_t Lost;     /**< Frames missing according to sequence numbers */
+    uint32_t Unsynced; /**< Deltas dropped while waiting for a keyframe */
+
+    uint8_t Buffer[EC_TELEMETRY_MAX_FRAME]; /**< Frame being received */
+    uint8_t Length;                         /**< Bytes held in Buffer */
+    uint8_t Overflow;                       /**< Current frame too long, skip to next delimiter */
+} EC_telemetryDecoder_t;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief Initializes an encoder
+ *
+ * @param[out] Encoder          Encoder to initialize
+ * @param[in]  Source           Source id (distinguishes instances sharing a link)
+ * @param[in]  KeyframeInterval Send a keyframe every KeyframeInterval calls of
+ *                              EC_telemetry_encode() (0 = only the first frame)
+ */
+void EC_telemetry_encoder_init(EC_telemetryEncoder_t *Encoder, uint8_t Source, uint16_t KeyframeInterval);
+
+/**
+ * @brief Forces a keyframe on the next call of EC_telemetry_encode()
+ *
+ * Use when the receiver reports loss or reconnects.
+ */
+void EC_telemetry_request_keyframe(EC_telemetryEncoder_t *Encoder);
+
+/**
+ * @brief Encodes the current state of an instance into a framed telemetry frame
+ *
+ * Call once per reporting period. A keyframe is produced when due, otherwise
+ * the smaller of a sparse or mask delta, or nothing if no bit changed.
+ *
+ * @param[in,out] Encoder  Encoder state
+ * @param[in]     Instance Instance to report
+ * @param[out]    Out      Output buffer
+ * @param[in]     Size     Size of Out (>= EC_TELEMETRY_MAX_FRAME)
+ *
+ * @return Number of bytes to send including the 0x00 delimiter, 0 if nothing changed
+ *
+ * @note Execution time: O(NumberOfErrors) worst case
+ */
+size_t EC_telemetry_encode(EC_telemetryEncoder_t *Encoder, const EC_instance_t *Instance, uint8_t *Out,
+                           size_t Size);
+
+/**
+ * @brief Initializes a streaming decoder
+ *
+ * @param[out] Decoder    Decoder to initialize
+ * @param[in]  Sources    Per-source state array (cleared here)
+ * @param[in]  NumSources Number of entries in Sources; frames of higher source ids are dropped
+ * @param[in]  OnFrame    Callback for every applied frame (may be NULL)
+ * @param[in]  Context    User pointer passed to OnFrame
+ */
+void EC_telemetry_decoder_init(EC_telemetryDecoder_t *Decoder, EC_telemetrySource_t *Sources, uint16_t NumSources,
+                               void (*OnFrame)(void *Context, const EC_telemetryFrame_t *Frame), void *Context);
+
+/**
+ * @brief Decodes a chunk of the received byte stream
+ *
+ * Accepts arbitrary chunk boundaries; frames may be split across calls.
+ */
+void EC_telemetry_decoder_feed(EC_telemetryDecoder_t *Decoder, const uint8_t *Data, size_t Size);
+
+#endif /* ERR_CORE_ERR_CORE_TELEMETRY_H_ */
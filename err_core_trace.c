@@ -0,0 +1,357 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#include "err_core_trace.h"
+#include "assert.h"
+
+/** Record types, in the low two bits of the record prefix */
+#define EC_TRACE_POLL 0u
+#define EC_TRACE_POLL_CHANGED 1u
+#define EC_TRACE_CLEAR 2u
+#define EC_TRACE_CHECK 3u
+
+/** Largest tick delta of one record, leaving room for the type bits */
+#define EC_TRACE_MAX_DELTA (UINT64_MAX >> 2)
+
+/** Tick source of the running replay */
+static EC_TIME_t EC_trace_tick;
+
+#if EC_TICK_FROM_FUNC
+/**
+ * Tick function registered during replay.
+ */
+static EC_TIME_t EC_trace_getTick(void)
+{
+    return EC_trace_tick;
+}
+#endif
+
+/**
+ * Encodes Value as LEB128 varint, returns number of bytes written (1-10).
+ */
+static uint8_t EC_trace_putVarint(uint8_t *Out, uint64_t Value)
+{
+    uint8_t len = 0;
+
+    while (Value >= 0x80u)
+    {
+        Out[len++] = (uint8_t)(Value | 0x80u);
+        Value >>= 7;
+    }
+    Out[len++] = (uint8_t)Value;
+
+    return len;
+}
+
+/**
+ * Decodes a LEB128 varint at Data[*Pos]. Returns 0 if truncated or too long.
+ */
+static uint8_t EC_trace_getVarint(const uint8_t *Data, size_t Size, size_t *Pos, uint64_t *Value)
+{
+    uint64_t value = 0;
+    size_t pos = *Pos;
+
+    for (uint8_t shift = 0; (shift < 70) && (pos < Size); shift += 7)
+    {
+        uint8_t byte = Data[pos++];
+        value |= (uint64_t)(byte & 0x7Fu) << shift;
+
+        if (!(byte & 0x80u))
+        {
+            *Pos = pos;
+            *Value = value;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Initializes a recorder and writes the stream header.
+ */
+void EC_trace_recorder_init(EC_traceRecorder_t *Recorder, uint8_t *Buffer, size_t Size,
+                            void (*Sink)(void *Context, const uint8_t *Data, size_t Size), void *Context,
+                            const EC_instance_t *Instance, EC_TIME_t Tick)
+{
+    assert(Recorder != NULL);
+    assert(Buffer != NULL);
+    assert(Size >= EC_TRACE_MAX_HEADER + EC_TRACE_MAX_RECORD);
+    assert(Instance != NULL);
+
+    Recorder->Buffer = Buffer;
+    Recorder->Size = Size;
+    Recorder->Sink = Sink;
+    Recorder->Context = Context;
+    Recorder->LastTick = Tick;
+    Recorder->LastPresent = 0;
+    Recorder->Polls = 0;
+    Recorder->Events = 0;
+    Recorder->Dropped = 0;
+
+    Buffer[0] = 'E';
+    Buffer[1] = 'C';
+    Buffer[2] = 'T';
+    Buffer[3] = EC_TRACE_VERSION;
+    Buffer[4] = Instance->NumberOfErrors;
+    Buffer[5] = sizeof(EC_TIME_t);
+    Recorder->Used = 6u + EC_trace_putVarint(&Buffer[6], (uint64_t)Tick);
+}
+
+/**
+ * Writes one record Delta ticks after the previous one, returns 0 if it was dropped.
+ */
+static uint8_t EC_trace_put(EC_traceRecorder_t *Recorder, uint64_t Delta, uint8_t Type, uint8_t HasPayload,
+                            uint64_t Payload)
+{
+    if (Recorder->Used + EC_TRACE_MAX_RECORD > Recorder->Size)
+    {
+        if (NULL == Recorder->Sink)
+        {
+            Recorder->Dropped++;
+            return 0;
+        }
+        EC_trace_flush(Recorder);
+    }
+
+    uint8_t *out = &Recorder->Buffer[Recorder->Used];
+    uint8_t len = EC_trace_putVarint(out, (Delta << 2) | Type);
+
+    if (HasPayload)
+    {
+        len += EC_trace_putVarint(&out[len], Payload);
+    }
+
+    Recorder->Used += len;
+    Recorder->LastTick = (EC_TIME_t)(Recorder->LastTick + (EC_TIME_t)Delta);
+
+    return 1;
+}
+
+/**
+ * Appends one record, returns 0 if it was dropped.
+ */
+static uint8_t EC_trace_append(EC_traceRecorder_t *Recorder, EC_TIME_t Tick, uint8_t Type, uint8_t HasPayload,
+                               uint64_t Payload)
+{
+    uint64_t delta = (uint64_t)(EC_TIME_t)(Tick - Recorder->LastTick);
+
+    // Only reachable with a 64-bit EC_TIME_t: the excess goes into clears of an empty mask
+    while (delta > EC_TRACE_MAX_DELTA)
+    {
+        if (!EC_trace_put(Recorder, EC_TRACE_MAX_DELTA, EC_TRACE_CLEAR, 1, 0))
+        {
+            return 0;
+        }
+        delta -= EC_TRACE_MAX_DELTA;
+    }
+
+    return EC_trace_put(Recorder, delta, Type, HasPayload, Payload);
+}
+
+/**
+ * Appends one poll record.
+ */
+void EC_trace_presence(void *Context, const EC_instance_t *Instance, EC_TIME_t Tick, uint64_t Evaluated,
+                       uint64_t Present)
+{
+    EC_traceRecorder_t *Recorder = (EC_traceRecorder_t *)Context;
+
+    assert(Recorder != NULL);
+    (void)Instance;
+    (void)Evaluated;
+
+    uint64_t changed = Present ^ Recorder->LastPresent;
+
+    if (EC_trace_append(Recorder, Tick, changed ? EC_TRACE_POLL_CHANGED : EC_TRACE_POLL, 0 != changed, changed))
+    {
+        Recorder->LastPresent = Present;
+        Recorder->Polls++;
+    }
+}
+
+/**
+ * Appends one clear or check record.
+ */
+void EC_trace_event(void *Context, const EC_instance_t *Instance, EC_TIME_t Tick, EC_event_t Event, uint64_t Arg)
+{
+    EC_traceRecorder_t *Recorder = (EC_traceRecorder_t *)Context;
+
+    assert(Recorder != NULL);
+    (void)Instance;
+
+    if (EC_trace_append(Recorder, Tick, (EC_EVENT_CLEAR == Event) ? EC_TRACE_CLEAR : EC_TRACE_CHECK, 1, Arg))
+    {
+        Recorder->Events++;
+    }
+}
+
+/**
+ * Connects a recorder to an instance.
+ */
+void EC_trace_attach(EC_traceRecorder_t *Recorder, EC_instance_t *Instance)
+{
+    assert(Recorder != NULL);
+    assert(Instance != NULL);
+
+    EC_presence_callback_register(Instance, EC_trace_presence, Recorder);
+    EC_event_callback_register(Instance, EC_trace_event, Recorder);
+}
+
+/**
+ * Passes the pending bytes to Sink.
+ */
+void EC_trace_flush(EC_traceRecorder_t *Recorder)
+{
+    assert(Recorder != NULL);
+
+    if ((NULL != Recorder->Sink) && (Recorder->Used > 0))
+    {
+        Recorder->Sink(Recorder->Context, Recorder->Buffer, Recorder->Used);
+        Recorder->Used = 0;
+    }
+}
+
+/**
+ * Validates a trace header and prepares the replay.
+ */
+EC_trace_status_t EC_trace_replay_init(EC_traceReplay_t *Replay, EC_instance_t *Instance, const uint8_t *Data,
+                                       size_t Size)
+{
+    assert(Replay != NULL);
+    assert(Instance != NULL);
+    assert((Data != NULL) || (0 == Size));
+
+    size_t pos = 6;
+    uint64_t tick;
+
+    if ((Size < pos) || ('E' != Data[0]) || ('C' != Data[1]) || ('T' != Data[2]) || (EC_TRACE_VERSION != Data[3]))
+    {
+        return EC_TRACE_BAD_FORMAT;
+    }
+    if ((Data[4] != Instance->NumberOfErrors) || (Data[5] != sizeof(EC_TIME_t)))
+    {
+        return EC_TRACE_MISMATCH;
+    }
+    if (!EC_trace_getVarint(Data, Size, &pos, &tick))
+    {
+        return EC_TRACE_BAD_FORMAT;
+    }
+
+    Replay->Data = Data;
+    Replay->Size = Size;
+    Replay->Pos = pos;
+    Replay->Instance = Instance;
+    Replay->Tick = (EC_TIME_t)tick;
+    Replay->Present = 0;
+    Replay->Polls = 0;
+    Replay->Events = 0;
+
+    EC_trace_tick = Replay->Tick;
+#if EC_TICK_FROM_FUNC
+    Replay->SavedTick = EC_get_tick;
+    EC_tick_function_register(EC_trace_getTick);
+#else
+    Replay->SavedTick = EC_tick;
+    EC_tick_variable_register(&EC_trace_tick);
+#endif
+    EC_presence_override(Instance, &Replay->Present);
+
+    return EC_TRACE_OK;
+}
+
+/**
+ * Replays one record.
+ */
+EC_trace_status_t EC_trace_replay_step(EC_traceReplay_t *Replay)
+{
+    assert(Replay != NULL);
+    assert(Replay->Instance != NULL);
+
+    EC_instance_t *instance = Replay->Instance;
+    uint64_t prefix;
+    uint64_t payload = 0;
+    EC_trace_status_t status = EC_TRACE_END;
+
+    if (Replay->Pos < Replay->Size)
+    {
+        status = EC_TRACE_BAD_FORMAT;
+
+        if (EC_trace_getVarint(Replay->Data, Replay->Size, &Replay->Pos, &prefix) &&
+            ((EC_TRACE_POLL == (prefix & 3u)) ||
+             EC_trace_getVarint(Replay->Data, Replay->Size, &Replay->Pos, &payload)))
+        {
+            uint8_t type = (uint8_t)(prefix & 3u);
+
+            Replay->Tick = (EC_TIME_t)(Replay->Tick + (EC_TIME_t)(prefix >> 2));
+            EC_trace_tick = Replay->Tick;
+
+            if ((EC_TRACE_CLEAR == type) && (0 == payload))
+            {
+                // Tick advance only
+                return EC_TRACE_OK;
+            }
+
+            if (EC_TRACE_CLEAR == type)
+            {
+                EC_clearMask(instance, payload);
+                Replay->Events++;
+                return EC_TRACE_OK;
+            }
+
+            if (EC_TRACE_CHECK == type)
+            {
+                uint8_t index = (uint8_t)(payload & 0xFFu);
+
+                if (index < instance->NumberOfErrors)
+                {
+                    // The recorded result, not the presence of the last poll
+                    uint64_t result = ((payload >> 8) & 1u) << index;
+
+                    EC_presence_override(instance, &result);
+                    EC_checkError(instance, index);
+                    EC_presence_override(instance, &Replay->Present);
+                    Replay->Events++;
+                    return EC_TRACE_OK;
+                }
+            }
+            else
+            {
+                Replay->Present ^= payload;
+                Replay->Polls++;
+                EC_poll(instance);
+                return EC_TRACE_OK;
+            }
+        }
+    }
+
+    EC_presence_override(instance, NULL);
+#if EC_TICK_FROM_FUNC
+    EC_get_tick = Replay->SavedTick;
+#else
+    EC_tick = Replay->SavedTick;
+#endif
+
+    return status;
+}
+
+/**
+ * Replays the whole remaining stream.
+ */
+EC_trace_status_t EC_trace_replay_run(EC_traceReplay_t *Replay)
+{
+    EC_trace_status_t status;
+
+    while (EC_TRACE_OK == (status = EC_trace_replay_step(Replay)))
+    {
+    }
+
+    return status;
+}
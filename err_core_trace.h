@@ -0,0 +1,243 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file err_core_trace.h
+ * @brief Error Core - Presence trace recorder and offline replay
+ *
+ * @details
+ * The recorder captures every input that changes the state of an instance
+ * into a compact byte stream: the ErrFunc results of every EC_poll() (tick
+ * at poll start + presence mask), clears (EC_clearMask(), EC_clearOneError(),
+ * EC_clearErr()) and EC_checkError() calls that evaluated an error. The
+ * replay driver feeds such a stream back through the same calls on the
+ * host, substituting the recorded results for the ErrFunc calls, so the
+ * exact sequence of warnings, errors, resets and clears seen in the field
+ * is reproduced.
+ *
+ * Stream layout:
+ * - Header: "ECT" + version, NumberOfErrors, sizeof(EC_TIME_t), varint start tick
+ * - Per record: varint((tick delta << 2) | type), followed by
+ *   | Type                 | Payload                                   |
+ *   |----------------------|-------------------------------------------|
+ *   | 0: poll, unchanged   | -                                         |
+ *   | 1: poll, changed     | varint(presence mask XOR previous mask)   |
+ *   | 2: clear             | varint(cleared mask)                      |
+ *   | 3: check             | varint(index \| result << 8)              |
+ *
+ * A clear of an empty mask only advances the replay tick. The recorder splits
+ * tick deltas of 2^62 and more (64-bit EC_TIME_t only) into such records, as
+ * they do not fit next to the type bits.
+ *
+ * A poll with unchanged presence and a constant polling period costs one or
+ * two bytes. Replay is a single pass of varint decoding and EC_poll() calls
+ * without any per-tick stepping between polls.
+ *
+ * @note Requires EC_USE_TRACE = 1.
+ * @note Only inputs through the library API are recorded. Changes made
+ *       directly to ErrorReg/RuntimeData or registers restored from a
+ *       snapshot are not part of the trace.
+ * @note One tick is recorded per poll. A tick source that advances during a
+ *       poll (e.g. an ISR-driven counter) can make the replay differ by one
+ *       tick on deadlines that fall inside such a poll.
+ * @note During replay errors are evaluated only if their ErrFunc is not NULL,
+ *       as on the device - keep the same error table (stubs are fine).
+ * @note Replay takes over the process-wide tick source from
+ *       EC_trace_replay_init() until the replay ends (any result of
+ *       EC_trace_replay_step() other than EC_TRACE_OK), then restores the
+ *       previously registered one. Only one replay can run at a time, and
+ *       other instances polled meanwhile see the replay tick.
+ *
+ * @example Recording on the device
+ * @code
+ * uint8_t trace_buf[512];
+ * EC_traceRecorder_t recorder;
+ *
+ * EC_trace_recorder_init(&recorder, trace_buf, sizeof(trace_buf), write_to_flash, NULL, &instance, system_tick);
+ * EC_trace_attach(&recorder, &instance);
+ * @endcode
+ *
+ * @example Replay on the host
+ * @code
+ * EC_traceReplay_t replay;
+ *
+ * EC_init(&instance, errors, runtime, NUM_ERRORS);
+ * EC_transition_callback_register(&instance, print_transition, NULL);
+ * if (EC_trace_replay_init(&replay, &instance, data, size) == EC_TRACE_OK) {
+ *     EC_trace_replay_run(&replay);
+ * }
+ * @endcode
+ */
+
+#ifndef ERR_CORE_ERR_CORE_TRACE_H_
+#define ERR_CORE_ERR_CORE_TRACE_H_
+
+#include "err_core.h"
+
+#if !EC_USE_TRACE
+#error "err_core_trace requires EC_USE_TRACE = 1"
+#endif
+
+/*******************************************************************************
+ * CONFIGURATION MACROS
+ ******************************************************************************/
+
+/** @brief Trace format version */
+#define EC_TRACE_VERSION 2u
+
+/** @brief Longest encoded header (magic, version, 2 bytes, start tick varint) */
+#define EC_TRACE_MAX_HEADER 16u
+
+/** @brief Longest encoded record (two varints) */
+#define EC_TRACE_MAX_RECORD 20u
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @enum EC_trace_status_t
+ * @brief Result of EC_trace_replay_init() and EC_trace_replay_step()
+ */
+typedef enum
+{
+    EC_TRACE_OK = 0,         /**< Header accepted / record replayed */
+    EC_TRACE_END = 1,        /**< End of the stream reached */
+    EC_TRACE_BAD_FORMAT = 2, /**< Wrong magic or version, truncated or invalid record */
+    EC_TRACE_MISMATCH = 3    /**< Different NumberOfErrors or tick width */
+} EC_trace_status_t;
+
+/**
+ * @struct EC_traceRecorder_t
+ * @brief Trace recorder state
+ */
+typedef struct
+{
+    uint8_t *Buffer; /**< Output buffer */
+    size_t Size;     /**< Size of Buffer */
+    size_t Used;     /**< Bytes pending in Buffer */
+
+    /** Receives full buffers (NULL = stop recording when the buffer is full) */
+    void (*Sink)(void *Context, const uint8_t *Data, size_t Size);
+    void *Context; /**< User pointer passed to Sink */
+
+    EC_TIME_t LastTick;   /**< Tick of the previous record */
+    uint64_t LastPresent; /**< Presence mask of the previous poll record */
+    uint32_t Polls;       /**< Recorded polls */
+    uint32_t Events;      /**< Recorded clears and checks */
+    uint32_t Dropped;     /**< Records lost because the buffer was full and Sink is NULL */
+} EC_traceRecorder_t;
+
+/**
+ * @struct EC_traceReplay_t
+ * @brief Trace replay state
+ */
+typedef struct
+{
+    const uint8_t *Data;     /**< Trace stream */
+    size_t Size;             /**< Size of Data */
+    size_t Pos;              /**< Read position */
+    EC_instance_t *Instance; /**< Instance driven by the replay */
+    EC_TIME_t Tick;          /**< Tick of the last replayed record */
+    uint64_t Present;        /**< Presence mask of the last replayed poll (override source) */
+    uint32_t Polls;          /**< Replayed polls */
+    uint32_t Events;         /**< Replayed clears and checks */
+#if EC_TICK_FROM_FUNC
+    EC_TIME_t (*SavedTick)(void); /**< Tick function registered before the replay */
+#else
+    EC_TIME_t *SavedTick; /**< Tick variable registered before the replay */
+#endif
+} EC_traceReplay_t;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief Initializes a recorder and writes the stream header
+ *
+ * @param[out] Recorder Recorder to initialize
+ * @param[in]  Buffer   Output buffer
+ * @param[in]  Size     Size of Buffer (>= EC_TRACE_MAX_HEADER + EC_TRACE_MAX_RECORD)
+ * @param[in]  Sink     Called with full buffers, or NULL to record until the buffer is full
+ * @param[in]  Context  User pointer passed to Sink
+ * @param[in]  Instance Recorded instance
+ * @param[in]  Tick     Current tick (start of the trace)
+ */
+void EC_trace_recorder_init(EC_traceRecorder_t *Recorder, uint8_t *Buffer, size_t Size,
+                            void (*Sink)(void *Context, const uint8_t *Data, size_t Size), void *Context,
+                            const EC_instance_t *Instance, EC_TIME_t Tick);
+
+/**
+ * @brief Presence callback appending one poll record
+ *
+ * Matches EC_presence_cb_t with an EC_traceRecorder_t as Context.
+ */
+void EC_trace_presence(void *Context, const EC_instance_t *Instance, EC_TIME_t Tick, uint64_t Evaluated,
+                       uint64_t Present);
+
+/**
+ * @brief Event callback appending one clear or check record
+ *
+ * Matches EC_event_cb_t with an EC_traceRecorder_t as Context.
+ */
+void EC_trace_event(void *Context, const EC_instance_t *Instance, EC_TIME_t Tick, EC_event_t Event, uint64_t Arg);
+
+/**
+ * @brief Connects a recorder to an instance
+ *
+ * Registers EC_trace_presence() as the presence callback and
+ * EC_trace_event() as the event callback of Instance.
+ */
+void EC_trace_attach(EC_traceRecorder_t *Recorder, EC_instance_t *Instance);
+
+/**
+ * @brief Passes the pending bytes to Sink
+ *
+ * The stream continues in the next buffer; the concatenated Sink output is
+ * one trace. Does nothing when Sink is NULL.
+ */
+void EC_trace_flush(EC_traceRecorder_t *Recorder);
+
+/**
+ * @brief Validates a trace header and prepares the replay
+ *
+ * Registers the replay tick as the tick source and the replayed presence
+ * mask as the presence override of Instance. The previous tick source is
+ * restored when the replay ends.
+ *
+ * @param[out]    Replay   Replay to initialize
+ * @param[in,out] Instance Freshly initialized instance with the recorded error table
+ * @param[in]     Data     Trace stream
+ * @param[in]     Size     Size of Data
+ *
+ * @return EC_TRACE_OK on success, error code otherwise (nothing is registered)
+ */
+EC_trace_status_t EC_trace_replay_init(EC_traceReplay_t *Replay, EC_instance_t *Instance, const uint8_t *Data,
+                                       size_t Size);
+
+/**
+ * @brief Replays one record: a poll, a clear or an EC_checkError() call
+ *
+ * @return EC_TRACE_OK after a replayed record, EC_TRACE_END at the end of the
+ *         stream, EC_TRACE_BAD_FORMAT on a truncated or invalid record. The
+ *         presence override is removed and the previous tick source restored
+ *         on anything but EC_TRACE_OK.
+ */
+EC_trace_status_t EC_trace_replay_step(EC_traceReplay_t *Replay);
+
+/**
+ * @brief Replays the whole remaining stream
+ *
+ * @return EC_TRACE_END when the stream was consumed, EC_TRACE_BAD_FORMAT if it was truncated
+ */
+EC_trace_status_t EC_trace_replay_run(EC_traceReplay_t *Replay);
+
+#endif /* ERR_CORE_ERR_CORE_TRACE_H_ */
@@ -0,0 +1,223 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file ec_bench.c
+ * @brief EC_poll() microbenchmark (Linux)
+ *
+ * @details
+ * Measures the cost of EC_poll() per error per poll for one build
+ * configuration (EC_TIME_t width, EC_TICK_FROM_FUNC and feature macros are
+ * selected with -D flags, see run.sh). Within one binary the matrix covers:
+ * - errors per instance: 1, 2, 4, 8, 16, 32, 64
+ * - instances: 1, 16, 256
+ * - input: quiescent (no condition present) or flapping (pseudo-random
+ *   presence, warnings registered and reset continuously)
+ *
+ * Every result is one CSV line:
+ * time_bits,tick_from_func,errors,instances,input,polls,ns_per_error,instr_per_error,cycles_per_error
+ *
+ * Instructions and cycles come from perf_event_open() (user space only);
+ * they are reported as -1 where the kernel denies access
+ * (see /proc/sys/kernel/perf_event_paranoid).
+ *
+ * Usage: ec_bench [min_errors_polled]   (default 20000000)
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "err_core.h"
+#include "linux/perf_event.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "sys/ioctl.h"
+#include "sys/syscall.h"
+#include "time.h"
+#include "unistd.h"
+
+#define EC_BENCH_MAX_INSTANCES 256u
+
+static EC_TIME_t bench_tick;
+
+#if EC_TICK_FROM_FUNC
+/**
+ * Tick source for EC_TICK_FROM_FUNC builds.
+ */
+static EC_TIME_t EC_bench_getTick(void)
+{
+    return bench_tick;
+}
+#endif
+
+/**
+ * Quiescent check - condition never present.
+ */
+static EC_err_state_t EC_bench_quiet(uint16_t Helper)
+{
+    (void)Helper;
+    return EC_NERR;
+}
+
+/**
+ * Flapping check - cheap hash of tick and helper, present about half of the time.
+ */
+static EC_err_state_t EC_bench_flap(uint16_t Helper)
+{
+    uint32_t x = ((uint32_t)bench_tick * 2654435761u) ^ ((uint32_t)Helper * 40503u);
+    x ^= x >> 15;
+
+    return (x & 1u) ? EC_ERR : EC_NERR;
+}
+
+/**
+ * Opens a user-space hardware counter, -1 if unavailable.
+ */
+static int EC_bench_counter(uint64_t Config)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = Config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static uint64_t EC_bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void EC_bench_start(int Fd)
+{
+    if (Fd >= 0)
+    {
+        ioctl(Fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(Fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static int64_t EC_bench_stop(int Fd)
+{
+    uint64_t value = 0;
+
+    if ((Fd < 0) || (0 != ioctl(Fd, PERF_EVENT_IOC_DISABLE, 0)) || (read(Fd, &value, sizeof(value)) != sizeof(value)))
+    {
+        return -1;
+    }
+
+    return (int64_t)value;
+}
+
+static EC_instance_t bench_instances[EC_BENCH_MAX_INSTANCES];
+static EC_runtimeData_t bench_runtime[EC_BENCH_MAX_INSTANCES][64];
+static EC_error_t bench_errors[2][64];
+
+/**
+ * Runs one matrix cell and prints its CSV line.
+ */
+static void EC_bench_run(uint8_t Errors, uint16_t Instances, uint8_t Flapping, uint64_t Budget, int Instr,
+                         int Cycles)
+{
+    memset(bench_instances, 0, sizeof(bench_instances));
+    memset(bench_runtime, 0, sizeof(bench_runtime));
+    for (uint16_t n = 0; n < Instances; n++)
+    {
+        EC_init(&bench_instances[n], bench_errors[Flapping], bench_runtime[n], Errors);
+    }
+
+    uint64_t polls = Budget / ((uint64_t)Errors * Instances);
+    if (polls < 1000u)
+    {
+        polls = 1000u;
+    }
+
+    // Warm-up: caches, branch predictors, steady-state warning pattern
+    for (uint32_t p = 0; p < 1000u; p++)
+    {
+        bench_tick++;
+        for (uint16_t n = 0; n < Instances; n++)
+        {
+            EC_poll(&bench_instances[n]);
+        }
+    }
+
+    EC_bench_start(Instr);
+    EC_bench_start(Cycles);
+    uint64_t start = EC_bench_now();
+
+    for (uint64_t p = 0; p < polls; p++)
+    {
+        bench_tick++;
+        for (uint16_t n = 0; n < Instances; n++)
+        {
+            EC_poll(&bench_instances[n]);
+        }
+    }
+
+    uint64_t elapsed = EC_bench_now() - start;
+    int64_t instructions = EC_bench_stop(Instr);
+    int64_t cycles = EC_bench_stop(Cycles);
+    double work = (double)polls * Errors * Instances;
+
+    printf("%u,%u,%u,%u,%s,%llu,%.3f,%.2f,%.2f\n", (unsigned)(8u * sizeof(EC_TIME_t)), (unsigned)EC_TICK_FROM_FUNC,
+           Errors, Instances, Flapping ? "flapping" : "quiescent", (unsigned long long)polls, (double)elapsed / work,
+           (instructions < 0) ? -1.0 : (double)instructions / work, (cycles < 0) ? -1.0 : (double)cycles / work);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    static const uint8_t errors[] = {1, 2, 4, 8, 16, 32, 64};
+    static const uint16_t instances[] = {1, 16, EC_BENCH_MAX_INSTANCES};
+    uint64_t budget = (argc > 1) ? strtoull(argv[1], NULL, 0) : 20000000u;
+
+#if EC_TICK_FROM_FUNC
+    EC_tick_function_register(EC_bench_getTick);
+#else
+    EC_tick_variable_register(&bench_tick);
+#endif
+
+    for (uint16_t i = 0; i < 64; i++)
+    {
+        // Short debounce so flapping inputs register warnings; the reset timeout
+        // keeps WarningCnt below WarningsToError so errors never latch
+        bench_errors[0][i] = (EC_error_t){.ErrFunc = EC_bench_quiet, .HelperNumber = i, .TimeToErrorRegister = 1,
+                                          .TimeToResetWarning = 4, .WarningsToError = 127};
+        bench_errors[1][i] = (EC_error_t){.ErrFunc = EC_bench_flap, .HelperNumber = i, .TimeToErrorRegister = 1,
+                                          .TimeToResetWarning = 4, .WarningsToError = 127};
+    }
+
+    int instr = EC_bench_counter(PERF_COUNT_HW_INSTRUCTIONS);
+    int cycles = EC_bench_counter(PERF_COUNT_HW_CPU_CYCLES);
+
+    for (uint8_t flapping = 0; flapping < 2; flapping++)
+    {
+        for (size_t e = 0; e < sizeof(errors) / sizeof(errors[0]); e++)
+        {
+            for (size_t n = 0; n < sizeof(instances) / sizeof(instances[0]); n++)
+            {
+                EC_bench_run(errors[e], instances[n], flapping, budget, instr, cycles);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#!/bin/sh
+#
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# Author: Adrian Pietrzak
+# GitHub: https://github.com/AdrianPietrzak1998
+# Created: Oct 16, 2026
+#
+# Builds ec_bench for every EC_TIME_t width and tick source and collects the
+# results into one CSV file.
+#
+# Usage:
+#   tools/bench/run.sh [output.csv] [baseline.csv]
+#
+# Environment:
+#   CC          compiler (default: cc)
+#   CFLAGS      extra flags, e.g. feature macros (-DEC_USE_STATS=1)
+#   BUDGET      errors polled per matrix cell (default: 20000000)
+#   THRESHOLD   regression threshold in percent for the baseline compare (default: 10)
+#
+# With a baseline, every cell whose ns_per_error grew by more than THRESHOLD
+# percent is listed and the script exits with status 1.
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+OUT=${1:-bench.csv}
+BASELINE=$2
+CC=${CC:-cc}
+BUDGET=${BUDGET:-20000000}
+THRESHOLD=${THRESHOLD:-10}
+BUILD=$(mktemp -d)
+trap 'rm -rf "$BUILD"' EXIT
+
+echo "time_bits,tick_from_func,errors,instances,input,polls,ns_per_error,instr_per_error,cycles_per_error" > "$OUT"
+
+for width in 8 16 32 64; do
+    for func in 0 1; do
+        "$CC" -std=c11 -O2 -DNDEBUG $CFLAGS \
+            -DEC_TIME_BASE_TYPE_CUSTOM="volatile uint${width}_t" -DEC_TIME_BASE_TYPE_CUSTOM_IS_UINT${width} \
+            -DEC_TICK_FROM_FUNC=$func -I"$ROOT" \
+            "$ROOT/tools/bench/ec_bench.c" "$ROOT/err_core.c" -o "$BUILD/ec_bench"
+        "$BUILD/ec_bench" "$BUDGET" | tee -a "$OUT"
+    done
+done
+
+if [ -n "$BASELINE" ]; then
+    awk -F, -v limit="$THRESHOLD" '
+        FNR == 1 { next }
+        NR == FNR { base[$1 FS $2 FS $3 FS $4 FS $5] = $7; next }
+        {
+            key = $1 FS $2 FS $3 FS $4 FS $5
+            if ((key in base) && base[key] > 0 && ($7 - base[key]) * 100 / base[key] > limit) {
+                printf "REGRESSION %s: %.3f -> %.3f ns/error\n", key, base[key], $7
+                bad = 1
+            }
+        }
+        END { exit bad }
+    ' "$BASELINE" "$OUT"
+fi
@@ -0,0 +1,321 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#include "ec_diff.h"
+#include "string.h"
+
+EC_TIME_t EC_diff_tick;
+
+/** Presence of every error, shared by both engines */
+static uint8_t diff_present[64];
+
+static const char *const diff_workload_names[EC_DIFF_WORKLOADS] = {"random", "boundary", "wrap", "flap"};
+
+#if EC_TICK_FROM_FUNC
+static EC_TIME_t EC_diff_getTick(void)
+{
+    return EC_diff_tick;
+}
+#endif
+
+/**
+ * ErrFunc of every generated error (HelperNumber = error index).
+ */
+static EC_err_state_t EC_diff_check(uint16_t HelperNumber)
+{
+    return diff_present[HelperNumber] ? EC_ERR : EC_NERR;
+}
+
+/**
+ * xorshift64* step.
+ */
+static uint64_t EC_diff_random(uint64_t *State)
+{
+    *State ^= *State >> 12;
+    *State ^= *State << 25;
+    *State ^= *State >> 27;
+
+    return *State * 2685821657736338717ull;
+}
+
+/**
+ * Random value in [0, Bound), 0 for Bound = 0.
+ */
+static uint64_t EC_diff_below(uint64_t *State, uint64_t Bound)
+{
+    return (0 == Bound) ? 0 : EC_diff_random(State) % Bound;
+}
+
+/**
+ * Picks a timing parameter, biased towards the corner cases.
+ */
+static uint64_t EC_diff_timing(uint64_t *Rng)
+{
+    switch (EC_diff_below(Rng, 8))
+    {
+    case 0:
+        return 0;
+    case 1:
+        return 1;
+    case 2:
+        return EC_MAX_TIMEOUT;
+    case 3:
+        return EC_MAX_TIMEOUT - 1;
+    case 4:
+        return EC_diff_below(Rng, 8);
+    default:
+        return EC_diff_below(Rng, 200);
+    }
+}
+
+/**
+ * Builds a random error table.
+ */
+static uint8_t EC_diff_table(uint64_t *Rng, EC_error_t *Errors)
+{
+    static const uint16_t thresholds[] = {0, 1, 1, 2, 3, 5, 127, 200};
+    uint8_t count = (uint8_t)(1 + EC_diff_below(Rng, 64));
+
+    memset(Errors, 0, 64 * sizeof(*Errors));
+    for (uint8_t i = 0; i < count; i++)
+    {
+        Errors[i].ErrFunc = (0 == EC_diff_below(Rng, 16)) ? NULL : EC_diff_check;
+        Errors[i].HelperNumber = i;
+        Errors[i].TimeToErrorRegister = (EC_TIME_t)EC_diff_timing(Rng);
+        Errors[i].TimeToResetWarning = (EC_TIME_t)EC_diff_timing(Rng);
+        Errors[i].WarningsToError = thresholds[EC_diff_below(Rng, sizeof(thresholds) / sizeof(thresholds[0]))];
+    }
+
+    return count;
+}
+
+/**
+ * Tick step landing next to a deadline of a random error of the reference.
+ */
+static uint64_t EC_diff_boundaryStep(uint64_t *Rng, const EC_instance_t *Instance)
+{
+    uint8_t i = (uint8_t)EC_diff_below(Rng, Instance->NumberOfErrors);
+    const EC_error_t *def = &Instance->Errors[i];
+    const EC_runtimeData_t *rt = &Instance->RuntimeData[i];
+    EC_TIME_t target = EC_diff_below(Rng, 2) ? (EC_TIME_t)(rt->LastNoErr + def->TimeToErrorRegister)
+                                             : (EC_TIME_t)(rt->LastReg + def->TimeToResetWarning);
+
+    target = (EC_TIME_t)(target + EC_diff_below(Rng, 3) - 1);
+
+    EC_TIME_t step = (EC_TIME_t)(target - EC_diff_tick);
+
+    // Deadlines already passed would mean a step of almost the full range
+    return (step > (EC_TIME_t)(EC_MAX_TIMEOUT / 2)) ? EC_diff_below(Rng, 3) : step;
+}
+
+/**
+ * Compares both instances, fills Report with the first difference.
+ */
+static uint8_t EC_diff_compare(const EC_instance_t *Ref, const EC_instance_t *Cand, EC_diffReport_t *Report)
+{
+    uint64_t diff = Ref->ErrorReg ^ Cand->ErrorReg;
+
+    if (diff)
+    {
+        Report->ErrorNumber = EC_lowestBit(diff);
+        Report->Field = "ErrorReg";
+        Report->Reference = (Ref->ErrorReg >> Report->ErrorNumber) & 1u;
+        Report->Candidate = (Cand->ErrorReg >> Report->ErrorNumber) & 1u;
+        return 0;
+    }
+
+    diff = Ref->WarningReg ^ Cand->WarningReg;
+    if (diff)
+    {
+        Report->ErrorNumber = EC_lowestBit(diff);
+        Report->Field = "WarningReg";
+        Report->Reference = (Ref->WarningReg >> Report->ErrorNumber) & 1u;
+        Report->Candidate = (Cand->WarningReg >> Report->ErrorNumber) & 1u;
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < Ref->NumberOfErrors; i++)
+    {
+        const EC_runtimeData_t *r = &Ref->RuntimeData[i];
+        const EC_runtimeData_t *c = &Cand->RuntimeData[i];
+
+        Report->ErrorNumber = i;
+        if (r->LastReg != c->LastReg)
+        {
+            Report->Field = "LastReg";
+            Report->Reference = r->LastReg;
+            Report->Candidate = c->LastReg;
+            return 0;
+        }
+        if (r->LastNoErr != c->LastNoErr)
+        {
+            Report->Field = "LastNoErr";
+            Report->Reference = r->LastNoErr;
+            Report->Candidate = c->LastNoErr;
+            return 0;
+        }
+        if (r->WarningCnt != c->WarningCnt)
+        {
+            Report->Field = "WarningCnt";
+            Report->Reference = r->WarningCnt;
+            Report->Candidate = c->WarningCnt;
+            return 0;
+        }
+        if (r->WarningPending != c->WarningPending)
+        {
+            Report->Field = "WarningPending";
+            Report->Reference = r->WarningPending;
+            Report->Candidate = c->WarningPending;
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * Returns the name of a workload.
+ */
+const char *EC_diff_workload_name(EC_diffWorkload_t Workload)
+{
+    return (Workload < EC_DIFF_WORKLOADS) ? diff_workload_names[Workload] : "?";
+}
+
+/**
+ * Runs the reference and a candidate engine in lockstep.
+ */
+uint8_t EC_diff_run(const EC_diffEngine_t *Candidate, EC_diffWorkload_t Workload, uint64_t Seed, uint64_t Steps,
+                    EC_diffReport_t *Report)
+{
+    static EC_error_t errors[64];
+    static EC_runtimeData_t ref_runtime[64];
+    static EC_runtimeData_t cand_runtime[64];
+    EC_instance_t ref;
+    EC_instance_t cand;
+    uint64_t rng = (Seed * 0x9E3779B97F4A7C15ull) | 1u;
+
+    memset(Report, 0, sizeof(*Report));
+    memset(diff_present, 0, sizeof(diff_present));
+    memset(ref_runtime, 0, sizeof(ref_runtime));
+    memset(cand_runtime, 0, sizeof(cand_runtime));
+    memset(&ref, 0, sizeof(ref));
+    memset(&cand, 0, sizeof(cand));
+
+    uint8_t count = EC_diff_table(&rng, errors);
+    EC_init(&ref, errors, ref_runtime, count);
+    EC_init(&cand, errors, cand_runtime, count);
+
+    EC_diff_tick = (EC_TIME_t)EC_diff_random(&rng);
+#if EC_TICK_FROM_FUNC
+    EC_tick_function_register(EC_diff_getTick);
+#else
+    EC_tick_variable_register(&EC_diff_tick);
+#endif
+
+    // Per-seed flip rate: from every other step to rarely
+    uint64_t flip_rate = 2 + EC_diff_below(&rng, 200);
+
+    for (uint64_t step = 0; step < Steps; step++)
+    {
+        EC_TIME_t dt;
+
+        switch (Workload)
+        {
+        case EC_DIFF_BOUNDARY:
+            dt = (EC_TIME_t)EC_diff_boundaryStep(&rng, &ref);
+            break;
+        case EC_DIFF_WRAP: {
+            static const uint8_t pick[] = {0, 1, 1, 1, 2, 3, 4};
+            switch (pick[EC_diff_below(&rng, sizeof(pick))])
+            {
+            case 0:
+                dt = 0;
+                break;
+            case 1:
+                dt = (EC_TIME_t)(1 + EC_diff_below(&rng, 4));
+                break;
+            case 2:
+                dt = (EC_TIME_t)(EC_MAX_TIMEOUT / 2 + EC_diff_below(&rng, 3) - 1);
+                break;
+            case 3:
+                dt = (EC_TIME_t)EC_MAX_TIMEOUT;
+                break;
+            default:
+                dt = (EC_TIME_t)(EC_MAX_TIMEOUT - EC_diff_below(&rng, 3));
+                break;
+            }
+            break;
+        }
+        case EC_DIFF_FLAP:
+            dt = 1;
+            break;
+        default:
+            dt = (EC_TIME_t)(EC_diff_below(&rng, 8) ? EC_diff_below(&rng, 4) : EC_diff_below(&rng, 300));
+            break;
+        }
+        EC_diff_tick = (EC_TIME_t)(EC_diff_tick + dt);
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            if ((EC_DIFF_FLAP == Workload) ? (i & 1u) || (0 == EC_diff_below(&rng, 4))
+                                           : (0 == EC_diff_below(&rng, flip_rate)))
+            {
+                diff_present[i] ^= 1u;
+            }
+        }
+
+        uint64_t op = EC_diff_below(&rng, 100);
+        EC_err_state_t ref_result = EC_NERR;
+        EC_err_state_t cand_result = EC_NERR;
+
+        if ((EC_DIFF_FLAP != Workload) && (op < 2))
+        {
+            uint8_t index = (uint8_t)EC_diff_below(&rng, count);
+
+            Report->Operation = "check";
+            ref_result = EC_diff_reference.CheckError(&ref, index);
+            cand_result = Candidate->CheckError(&cand, index);
+            Report->ErrorNumber = index;
+        }
+        else if ((EC_DIFF_FLAP != Workload) && (op < 4))
+        {
+            uint64_t mask = (0 == op) ? UINT64_MAX : EC_diff_random(&rng);
+
+            Report->Operation = "clear";
+            EC_diff_reference.ClearMask(&ref, mask);
+            Candidate->ClearMask(&cand, mask);
+        }
+        else
+        {
+            Report->Operation = "poll";
+            EC_diff_reference.Poll(&ref);
+            Candidate->Poll(&cand);
+        }
+
+        Report->Step = step;
+        Report->Tick = EC_diff_tick;
+
+        if (ref_result != cand_result)
+        {
+            Report->Field = "return value";
+            Report->Reference = ref_result;
+            Report->Candidate = cand_result;
+            Report->Diverged = 1;
+            return 0;
+        }
+        if (!EC_diff_compare(&ref, &cand, Report))
+        {
+            Report->Diverged = 1;
+            return 0;
+        }
+    }
+
+    return 1;
+}
@@ -0,0 +1,124 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file ec_diff.h
+ * @brief Differential test harness for poll engines
+ *
+ * @details
+ * Runs two engines in lockstep on identical error tables and identical
+ * presence inputs and compares the complete state after every step:
+ * ErrorReg, WarningReg and every field of EC_runtimeData_t, plus the return
+ * value of EC_checkError(). The first difference is reported with its step,
+ * tick, error index and field.
+ *
+ * The reference engine (ec_diff_ref.c) is a frozen copy of the EC_poll()
+ * state machine without optional features. Alternative engines - the
+ * library itself, or SIMD/bitmask/parallel variants - implement
+ * EC_diffEngine_t and are listed in ec_diff_main.c.
+ *
+ * Workloads (all derived from a 64-bit seed, fully reproducible):
+ * - random:   random error tables, presence flips, tick steps, clears and checks
+ * - boundary: tick steps landing on debounce and reset deadlines -1/0/+1
+ * - wrap:     tick steps of 0, 1, half range and full range - 1 across the wrap point
+ * - flap:     presence toggling on every poll with 1-tick steps
+ *
+ * Error tables include the corner cases TimeToErrorRegister = 0,
+ * TimeToResetWarning = 0 and EC_MAX_TIMEOUT, WarningsToError = 0 and values
+ * above the 7-bit WarningCnt range, and errors without ErrFunc.
+ */
+
+#ifndef ERR_CORE_TOOLS_EC_DIFF_H_
+#define ERR_CORE_TOOLS_EC_DIFF_H_
+
+#include "err_core.h"
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @struct EC_diffEngine_t
+ * @brief Poll engine under test
+ *
+ * Engines read the tick from the registered tick source (the harness
+ * registers EC_diff_tick) and the presence from the ErrFunc of the table.
+ */
+typedef struct
+{
+    const char *Name;                                                     /**< Engine name */
+    void (*Poll)(EC_instance_t *Instance);                                /**< EC_poll() equivalent */
+    EC_err_state_t (*CheckError)(EC_instance_t *Instance, uint8_t Index); /**< EC_checkError() equivalent */
+    void (*ClearMask)(EC_instance_t *Instance, uint64_t Mask);            /**< EC_clearMask() equivalent */
+} EC_diffEngine_t;
+
+/**
+ * @enum EC_diffWorkload_t
+ * @brief Input generators
+ */
+typedef enum
+{
+    EC_DIFF_RANDOM = 0,   /**< Random mix of all operations */
+    EC_DIFF_BOUNDARY = 1, /**< Ticks on debounce/reset deadlines */
+    EC_DIFF_WRAP = 2,     /**< Large tick steps across the wrap point */
+    EC_DIFF_FLAP = 3,     /**< Presence toggling every poll */
+    EC_DIFF_WORKLOADS = 4
+} EC_diffWorkload_t;
+
+/**
+ * @struct EC_diffReport_t
+ * @brief First divergence of a run
+ */
+typedef struct
+{
+    uint8_t Diverged;      /**< 1 if the engines diverged */
+    uint64_t Step;         /**< Step of the divergence */
+    uint64_t Tick;         /**< Tick of the divergence */
+    const char *Operation; /**< Operation of that step (poll, check, clear) */
+    uint8_t ErrorNumber;   /**< First differing error index */
+    const char *Field;     /**< First differing field */
+    uint64_t Reference;    /**< Value in the reference engine */
+    uint64_t Candidate;    /**< Value in the candidate engine */
+} EC_diffReport_t;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/** @brief Harness tick, registered as tick source and read by the reference engine */
+extern EC_TIME_t EC_diff_tick;
+
+/** @brief Frozen reference engine */
+extern const EC_diffEngine_t EC_diff_reference;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief Returns the name of a workload
+ */
+const char *EC_diff_workload_name(EC_diffWorkload_t Workload);
+
+/**
+ * @brief Runs the reference and a candidate engine in lockstep
+ *
+ * @param[in]  Candidate Engine under test
+ * @param[in]  Workload  Input generator
+ * @param[in]  Seed      Seed of the error table and the inputs
+ * @param[in]  Steps     Number of steps
+ * @param[out] Report    First divergence (Diverged = 0 if none)
+ *
+ * @return 1 if the engines matched on every step, 0 otherwise
+ */
+uint8_t EC_diff_run(const EC_diffEngine_t *Candidate, EC_diffWorkload_t Workload, uint64_t Seed, uint64_t Steps,
+                    EC_diffReport_t *Report);
+
+#endif /* ERR_CORE_TOOLS_EC_DIFF_H_ */
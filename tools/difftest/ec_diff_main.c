@@ -0,0 +1,140 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file ec_diff_main.c
+ * @brief Differential test runner
+ *
+ * @details
+ * Runs every workload with a range of seeds against every candidate engine
+ * (or the one selected with --engine) and prints the first divergence:
+ *
+ *     DIVERGED library/boundary seed 17 step 4711 tick 65534 (poll): error 5 LastReg ref 65533 cand 65534
+ *
+ * Re-running with --seed 17 --workload boundary reproduces it.
+ *
+ * To test a new engine, add it to diff_engines[] below.
+ *
+ * Build: cc -std=c11 -O2 -I. -Itools/difftest tools/difftest/ec_diff*.c err_core.c -o ec_diff
+ * Usage: ec_diff [--engine NAME] [--workload NAME] [--seed N] [--seeds N] [--steps N]
+ */
+
+#include "ec_diff.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+/** Candidate engines */
+static const EC_diffEngine_t diff_engines[] = {
+    {"library", EC_poll, EC_checkError, EC_clearMask},
+};
+
+#define DIFF_ENGINES (sizeof(diff_engines) / sizeof(diff_engines[0]))
+
+int main(int argc, char **argv)
+{
+    const char *engine = NULL;
+    int workload = -1;
+    uint64_t first_seed = 1;
+    uint64_t seeds = 200;
+    uint64_t steps = 20000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if ((NULL != value) && (0 == strcmp(argv[i], "--engine")))
+        {
+            engine = value;
+        }
+        else if ((NULL != value) && (0 == strcmp(argv[i], "--workload")))
+        {
+            for (int w = 0; w < EC_DIFF_WORKLOADS; w++)
+            {
+                if (0 == strcmp(value, EC_diff_workload_name((EC_diffWorkload_t)w)))
+                {
+                    workload = w;
+                }
+            }
+            if (workload < 0)
+            {
+                fprintf(stderr, "unknown workload %s\n", value);
+                return 2;
+            }
+        }
+        else if ((NULL != value) && (0 == strcmp(argv[i], "--seed")))
+        {
+            first_seed = strtoull(value, NULL, 0);
+            seeds = 1;
+        }
+        else if ((NULL != value) && (0 == strcmp(argv[i], "--seeds")))
+        {
+            seeds = strtoull(value, NULL, 0);
+        }
+        else if ((NULL != value) && (0 == strcmp(argv[i], "--steps")))
+        {
+            steps = strtoull(value, NULL, 0);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--engine NAME] [--workload NAME] [--seed N] [--seeds N] [--steps N]\n",
+                    argv[0]);
+            return 2;
+        }
+        i++;
+    }
+
+    int failures = 0;
+
+    for (size_t e = 0; e < DIFF_ENGINES; e++)
+    {
+        if ((NULL != engine) && (0 != strcmp(engine, diff_engines[e].Name)))
+        {
+            continue;
+        }
+
+        for (int w = 0; w < EC_DIFF_WORKLOADS; w++)
+        {
+            if ((workload >= 0) && (workload != w))
+            {
+                continue;
+            }
+
+            EC_diffReport_t report;
+            uint64_t seed;
+
+            for (seed = first_seed; seed < first_seed + seeds; seed++)
+            {
+                if (!EC_diff_run(&diff_engines[e], (EC_diffWorkload_t)w, seed, steps, &report))
+                {
+                    break;
+                }
+            }
+
+            if (report.Diverged)
+            {
+                printf("DIVERGED %s/%s seed %llu step %llu tick %llu (%s): error %u %s ref %llu cand %llu\n",
+                       diff_engines[e].Name, EC_diff_workload_name((EC_diffWorkload_t)w), (unsigned long long)seed,
+                       (unsigned long long)report.Step, (unsigned long long)report.Tick, report.Operation,
+                       report.ErrorNumber, report.Field, (unsigned long long)report.Reference,
+                       (unsigned long long)report.Candidate);
+                failures++;
+            }
+            else
+            {
+                printf("OK %s/%s: %llu seeds x %llu steps, EC_TIME_t %u bit\n", diff_engines[e].Name,
+                       EC_diff_workload_name((EC_diffWorkload_t)w), (unsigned long long)seeds,
+                       (unsigned long long)steps, (unsigned)(8 * sizeof(EC_TIME_t)));
+            }
+        }
+    }
+
+    return failures ? 1 : 0;
+}
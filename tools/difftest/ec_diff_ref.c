@@ -0,0 +1,127 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file ec_diff_ref.c
+ * @brief Frozen reference engine for differential testing
+ *
+ * @details
+ * Copy of the EC_poll(), EC_checkError() and EC_clearMask() state machine
+ * with all optional features stripped. Do not optimize this file: it
+ * defines the expected behaviour. Change it only together with an intended
+ * change of the library semantics, and list the change here.
+ *
+ * Intended semantics changes since the reference was frozen:
+ * - EC_checkError() clears the WarningReg bit, WarningCnt and WarningPending
+ *   of the error it registers, as escalation in EC_poll() does. Before, the
+ *   warning state was left untouched and the error could be set in ErrorReg
+ *   and WarningReg at once.
+ */
+
+#include "ec_diff.h"
+
+/**
+ * Reference EC_poll().
+ */
+static void EC_ref_poll(EC_instance_t *Instance)
+{
+    EC_TIME_t current_tick = EC_diff_tick;
+
+    for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+    {
+        const EC_error_t *def = &Instance->Errors[i];
+        EC_runtimeData_t *rt = &Instance->RuntimeData[i];
+        uint64_t bit = (uint64_t)1 << i;
+
+        if (!(Instance->ErrorReg & bit) && (NULL != def->ErrFunc))
+        {
+            if (EC_NERR == def->ErrFunc(def->HelperNumber))
+            {
+                rt->LastNoErr = current_tick;
+                rt->WarningPending = 0;
+            }
+            else if ((0 == rt->WarningPending) &&
+                     ((EC_TIME_t)(current_tick - rt->LastNoErr) >= def->TimeToErrorRegister))
+            {
+                rt->WarningCnt++;
+                if (rt->WarningCnt >= def->WarningsToError)
+                {
+                    Instance->ErrorReg |= bit;
+                    Instance->WarningReg &= ~bit;
+                    rt->WarningCnt = 0;
+                }
+                else
+                {
+                    Instance->WarningReg |= bit;
+                    rt->WarningPending = 1;
+                }
+                rt->LastReg = current_tick;
+            }
+        }
+
+        if ((EC_TIME_t)(current_tick - rt->LastReg) >= def->TimeToResetWarning)
+        {
+            Instance->WarningReg &= ~bit;
+            rt->WarningCnt = 0;
+            rt->WarningPending = 0;
+        }
+    }
+}
+
+/**
+ * Reference EC_checkError().
+ */
+static EC_err_state_t EC_ref_checkError(EC_instance_t *Instance, uint8_t ErrorNumber)
+{
+    uint64_t bit = (uint64_t)1 << ErrorNumber;
+
+    if (Instance->ErrorReg & bit)
+    {
+        return EC_ERR;
+    }
+    if (NULL == Instance->Errors[ErrorNumber].ErrFunc)
+    {
+        return EC_NERR;
+    }
+    if (EC_ERR == Instance->Errors[ErrorNumber].ErrFunc(Instance->Errors[ErrorNumber].HelperNumber))
+    {
+        Instance->ErrorReg |= bit;
+        // Semantics change, see file header
+        Instance->WarningReg &= ~bit;
+        Instance->RuntimeData[ErrorNumber].WarningCnt = 0;
+        Instance->RuntimeData[ErrorNumber].WarningPending = 0;
+        return EC_ERR;
+    }
+
+    return EC_NERR;
+}
+
+/**
+ * Reference EC_clearMask().
+ */
+static void EC_ref_clearMask(EC_instance_t *Instance, uint64_t Mask)
+{
+    Mask &= EC_ALL_ERRORS_MASK(Instance->NumberOfErrors);
+
+    Instance->ErrorReg &= ~Mask;
+    Instance->WarningReg &= ~Mask;
+
+    for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+    {
+        if (Mask & ((uint64_t)1 << i))
+        {
+            Instance->RuntimeData[i].LastNoErr = EC_diff_tick;
+            Instance->RuntimeData[i].WarningCnt = 0;
+            Instance->RuntimeData[i].WarningPending = 0;
+        }
+    }
+}
+
+const EC_diffEngine_t EC_diff_reference = {"reference", EC_ref_poll, EC_ref_checkError, EC_ref_clearMask};
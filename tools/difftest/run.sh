@@ -0,0 +1,37 @@
+#!/bin/sh
+#
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#
+# Author: Adrian Pietrzak
+# GitHub: https://github.com/AdrianPietrzak1998
+# Created: Oct 16, 2026
+#
+# Builds ec_diff for every EC_TIME_t width and tick source and runs all
+# engines and workloads. Exits with status 1 on the first divergent build.
+#
+# Usage:
+#   tools/difftest/run.sh [ec_diff options]
+#
+# Environment:
+#   CC          compiler (default: cc)
+#   CFLAGS      extra flags, e.g. feature macros (-DEC_USE_STATS=1)
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+CC=${CC:-cc}
+BUILD=$(mktemp -d)
+trap 'rm -rf "$BUILD"' EXIT
+
+for width in 8 16 32 64; do
+    for func in 0 1; do
+        echo "== EC_TIME_t uint${width}_t, EC_TICK_FROM_FUNC=$func"
+        "$CC" -std=c11 -O2 $CFLAGS \
+            -DEC_TIME_BASE_TYPE_CUSTOM="volatile uint${width}_t" -DEC_TIME_BASE_TYPE_CUSTOM_IS_UINT${width} \
+            -DEC_TICK_FROM_FUNC=$func -I"$ROOT" -I"$ROOT/tools/difftest" \
+            "$ROOT"/tools/difftest/ec_diff*.c "$ROOT/err_core.c" -o "$BUILD/ec_diff"
+        "$BUILD/ec_diff" "$@"
+    done
+done
@@ -0,0 +1,313 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file ec_fuzz.c
+ * @brief Coverage-guided fuzz target for the error state machine
+ *
+ * @details
+ * Interprets the fuzz input as an error table followed by a program of
+ * operations on one instance and checks the state machine invariants after
+ * every operation.
+ *
+ * Input layout:
+ * - byte 0: NumberOfErrors - 1 (mod 64)
+ * - 4 bytes per error: TimeToErrorRegister, TimeToResetWarning (0xFF = EC_MAX_TIMEOUT),
+ *   WarningsToError, flags (bit 0: no ErrFunc)
+ * - operations, one byte each: opcode in bits 7-5, argument in bits 4-0
+ *   | Opcode | Operation                                              |
+ *   |--------|--------------------------------------------------------|
+ *   | 0      | tick += argument, poll                                 |
+ *   | 1      | tick += argument << 8 or EC_MAX_TIMEOUT - argument, poll |
+ *   | 2      | toggle presence of error (next byte)                   |
+ *   | 3      | set presence mask (next 8 bytes)                       |
+ *   | 4      | poll without tick change                               |
+ *   | 5      | EC_checkError() on error (next byte)                   |
+ *   | 6      | EC_clearMask() (next 8 bytes)                          |
+ *   | 7      | EC_clearErr()                                          |
+ *
+ * Invariants (checked after every operation):
+ * - no register bit beyond NumberOfErrors, ErrorReg and WarningReg disjoint
+ * - errors without ErrFunc never register
+ * - WarningPending implies the WarningReg bit
+ * - WarningReg implies WarningCnt >= 1 and WarningCnt stays below
+ *   WarningsToError (for WarningsToError <= 127, the WarningCnt range)
+ * - ErrorReg bits are only added for present errors and only removed by a clear
+ * - after a poll every evaluated absent error has LastNoErr = tick and no
+ *   pending warning
+ * - after a clear the cleared errors have no register bits and WarningCnt = 0
+ *
+ * A violated invariant prints its name and aborts, which libFuzzer reports
+ * as a crash with the reproducing input.
+ *
+ * Build (libFuzzer):
+ *   clang -std=c11 -g -O1 -fsanitize=fuzzer,address,undefined -I. tools/fuzz/ec_fuzz.c err_core.c -o ec_fuzz
+ * Build (standalone replay/random driver, any compiler):
+ *   cc -std=c11 -O2 -DEC_FUZZ_STANDALONE -I. tools/fuzz/ec_fuzz.c err_core.c -o ec_fuzz
+ *   ec_fuzz [file...]       replays the files, or runs random inputs without arguments
+ */
+
+#include "err_core.h"
+#include "stddef.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+#define EC_FUZZ_CHECK(Condition, Name)                                                                                 \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(Condition))                                                                                              \
+        {                                                                                                              \
+            fprintf(stderr, "invariant violated: %s (op %zu, tick %llu)\n", Name, fuzz_op,                            \
+                    (unsigned long long)fuzz_tick);                                                                    \
+            abort();                                                                                                   \
+        }                                                                                                              \
+    } while (0)
+
+static EC_TIME_t fuzz_tick;
+static uint64_t fuzz_present;
+static size_t fuzz_op;
+
+#if EC_TICK_FROM_FUNC
+static EC_TIME_t EC_fuzz_getTick(void)
+{
+    return fuzz_tick;
+}
+#endif
+
+/**
+ * ErrFunc of every fuzzed error (HelperNumber = error index).
+ */
+static EC_err_state_t EC_fuzz_check(uint16_t HelperNumber)
+{
+    return ((fuzz_present >> HelperNumber) & 1u) ? EC_ERR : EC_NERR;
+}
+
+/**
+ * Reads Size little-endian bytes, missing bytes read as 0.
+ */
+static uint64_t EC_fuzz_get(const uint8_t *Data, size_t Size, size_t *Pos, uint8_t Bytes)
+{
+    uint64_t value = 0;
+
+    for (uint8_t i = 0; (i < Bytes) && (*Pos < Size); i++)
+    {
+        value |= (uint64_t)Data[(*Pos)++] << (8u * i);
+    }
+
+    return value;
+}
+
+/**
+ * Checks the invariants that hold after every operation.
+ */
+static void EC_fuzz_invariants(const EC_instance_t *Instance, uint64_t Callable)
+{
+    uint64_t valid = EC_ALL_ERRORS_MASK(Instance->NumberOfErrors);
+
+    EC_FUZZ_CHECK(0 == ((Instance->ErrorReg | Instance->WarningReg) & ~valid), "register bit out of range");
+    EC_FUZZ_CHECK(0 == (Instance->ErrorReg & Instance->WarningReg), "error and warning set together");
+    EC_FUZZ_CHECK(0 == ((Instance->ErrorReg | Instance->WarningReg) & ~Callable), "error without ErrFunc registered");
+
+    for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+    {
+        const EC_runtimeData_t *rt = &Instance->RuntimeData[i];
+        uint16_t threshold = Instance->Errors[i].WarningsToError;
+        uint8_t warning = (Instance->WarningReg >> i) & 1u;
+
+        EC_FUZZ_CHECK(!rt->WarningPending || warning, "WarningPending without warning");
+        if (threshold <= 127)
+        {
+            EC_FUZZ_CHECK(!warning || (rt->WarningCnt >= 1), "warning with zero WarningCnt");
+            EC_FUZZ_CHECK(rt->WarningCnt < ((threshold > 0) ? threshold : 1), "WarningCnt reached WarningsToError");
+        }
+    }
+}
+
+/**
+ * Fuzz entry point.
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size)
+{
+    static EC_error_t errors[64];
+    static EC_runtimeData_t runtime[64];
+    EC_instance_t instance;
+    size_t pos = 0;
+
+    if (Size < 1)
+    {
+        return 0;
+    }
+
+    uint8_t count = (uint8_t)(1 + Data[pos++] % 64);
+    uint64_t callable = 0;
+
+    memset(errors, 0, sizeof(errors));
+    memset(runtime, 0, sizeof(runtime));
+    memset(&instance, 0, sizeof(instance));
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint8_t tter = (uint8_t)EC_fuzz_get(Data, Size, &pos, 1);
+        uint8_t ttrw = (uint8_t)EC_fuzz_get(Data, Size, &pos, 1);
+
+        errors[i].HelperNumber = i;
+        errors[i].TimeToErrorRegister = (0xFFu == tter) ? (EC_TIME_t)EC_MAX_TIMEOUT : (EC_TIME_t)tter;
+        errors[i].TimeToResetWarning = (0xFFu == ttrw) ? (EC_TIME_t)EC_MAX_TIMEOUT : (EC_TIME_t)ttrw;
+        errors[i].WarningsToError = (uint16_t)EC_fuzz_get(Data, Size, &pos, 1);
+        if (!(EC_fuzz_get(Data, Size, &pos, 1) & 1u))
+        {
+            errors[i].ErrFunc = EC_fuzz_check;
+            callable |= (uint64_t)1 << i;
+        }
+    }
+
+    fuzz_tick = 0;
+    fuzz_present = 0;
+#if EC_TICK_FROM_FUNC
+    EC_tick_function_register(EC_fuzz_getTick);
+#else
+    EC_tick_variable_register(&fuzz_tick);
+#endif
+    EC_init(&instance, errors, runtime, count);
+
+    for (fuzz_op = 0; pos < Size; fuzz_op++)
+    {
+        uint8_t code = Data[pos++];
+        uint8_t arg = code & 0x1Fu;
+        uint64_t before = instance.ErrorReg;
+        uint64_t cleared = 0;
+        uint8_t polled = 0;
+
+        switch (code >> 5)
+        {
+        case 0:
+            fuzz_tick = (EC_TIME_t)(fuzz_tick + arg);
+            polled = 1;
+            break;
+        case 1:
+            fuzz_tick = (EC_TIME_t)(fuzz_tick + ((arg & 1u) ? (EC_TIME_t)(EC_MAX_TIMEOUT - (arg >> 1))
+                                                            : (EC_TIME_t)((uint64_t)arg << 8)));
+            polled = 1;
+            break;
+        case 2:
+            fuzz_present ^= (uint64_t)1 << (EC_fuzz_get(Data, Size, &pos, 1) % 64);
+            break;
+        case 3:
+            fuzz_present = EC_fuzz_get(Data, Size, &pos, 8);
+            break;
+        case 4:
+            polled = 1;
+            break;
+        case 5: {
+            uint8_t index = (uint8_t)(EC_fuzz_get(Data, Size, &pos, 1) % count);
+            EC_err_state_t result = EC_checkError(&instance, index);
+
+            EC_FUZZ_CHECK((EC_ERR == result) == (0 != (instance.ErrorReg & ((uint64_t)1 << index))),
+                          "EC_checkError result differs from ErrorReg");
+            break;
+        }
+        case 6:
+            cleared = EC_fuzz_get(Data, Size, &pos, 8);
+            EC_clearMask(&instance, cleared);
+            break;
+        default:
+            cleared = UINT64_MAX;
+            EC_clearErr(&instance);
+            break;
+        }
+
+        if (polled)
+        {
+            EC_poll(&instance);
+
+            for (uint8_t i = 0; i < count; i++)
+            {
+                uint64_t bit = (uint64_t)1 << i;
+
+                if ((callable & bit) && !(before & bit) && !(fuzz_present & bit))
+                {
+                    EC_FUZZ_CHECK(instance.RuntimeData[i].LastNoErr == fuzz_tick, "absent error without LastNoErr");
+                    EC_FUZZ_CHECK(!instance.RuntimeData[i].WarningPending, "absent error with pending warning");
+                }
+            }
+        }
+
+        cleared &= EC_ALL_ERRORS_MASK(count);
+        EC_FUZZ_CHECK(0 == (before & ~cleared & ~instance.ErrorReg), "error vanished without clear");
+        EC_FUZZ_CHECK(0 == (instance.ErrorReg & ~before & ~fuzz_present), "absent error registered");
+        EC_FUZZ_CHECK(0 == ((instance.ErrorReg | instance.WarningReg) & cleared), "cleared error still set");
+        for (uint8_t i = 0; i < count; i++)
+        {
+            EC_FUZZ_CHECK(!((cleared >> i) & 1u) || (0 == instance.RuntimeData[i].WarningCnt),
+                          "cleared error kept WarningCnt");
+        }
+
+        EC_fuzz_invariants(&instance, callable);
+    }
+
+    return 0;
+}
+
+#ifdef EC_FUZZ_STANDALONE
+
+#include "time.h"
+
+/**
+ * Replays input files, or runs random inputs when no file is given.
+ */
+int main(int argc, char **argv)
+{
+    static uint8_t buffer[1 << 16];
+
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            FILE *f = fopen(argv[i], "rb");
+            if (NULL == f)
+            {
+                perror(argv[i]);
+                return 2;
+            }
+            size_t size = fread(buffer, 1, sizeof(buffer), f);
+            fclose(f);
+            LLVMFuzzerTestOneInput(buffer, size);
+        }
+        printf("%d inputs OK\n", argc - 1);
+        return 0;
+    }
+
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    uint64_t runs = 0;
+    time_t start = time(NULL);
+
+    while (time(NULL) - start < 10)
+    {
+        for (uint32_t n = 0; n < 1000; n++, runs++)
+        {
+            size_t size = 1 + (size_t)(rng % 512);
+
+            for (size_t i = 0; i < size; i++)
+            {
+                rng ^= rng >> 12;
+                rng ^= rng << 25;
+                rng ^= rng >> 27;
+                buffer[i] = (uint8_t)((rng * 2685821657736338717ull) >> 56);
+            }
+            LLVMFuzzerTestOneInput(buffer, size);
+        }
+    }
+    printf("%llu random inputs OK (%.1f M/min)\n", (unsigned long long)runs, (double)runs * 6.0 / 1e6);
+
+    return 0;
+}
+
+#endif
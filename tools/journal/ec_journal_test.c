@@ -0,0 +1,404 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file ec_journal_test.c
+ * @brief Crash-recovery harness for the persistent event journal
+ *
+ * @details
+ * Exercises EC_journal_open() and EC_journal_recover() on a scratch file:
+ * - fill: fewer records than slots, all recovered in order
+ * - wrap: many times the capacity, exactly the newest Capacity records recovered
+ * - reopen: writing resumes after the newest record, a different capacity
+ *   fails with EEXIST and leaves the history untouched
+ * - foreign: a non-empty file without journal magic fails with EPROTO and
+ *   keeps its content, an empty file is formatted
+ * - torn: the newest record overwritten with only its first 0..39 bytes
+ *   (every tear point), recovery ends at the previous record and a reopen
+ *   resumes there
+ * - gap: a torn record in the middle of the ring, recovery returns only the
+ *   records after it
+ * - kill: a child process appends records in a loop and is killed with
+ *   SIGKILL at a random moment, repeatedly; the recovered history must be
+ *   consecutive, with valid content, and end at most one record before the
+ *   child's last completed write
+ *
+ * Record content is derived from the sequence number, so every recovered
+ * record is checked field by field.
+ *
+ * Build: cc -std=c11 -O2 -I. tools/journal/ec_journal_test.c err_core_journal.c err_core.c -o ec_journal_test
+ * Usage: ec_journal_test [scratch file]   (default: $TMPDIR/ec_journal_test.jnl)
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "err_core_journal.h"
+#include "errno.h"
+#include "signal.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "sys/wait.h"
+#include "time.h"
+#include "unistd.h"
+
+#define JT_CAPACITY 64u
+
+static uint32_t jt_failures;
+static const char *jt_path;
+
+/** Recovery result collected by the callback */
+typedef struct
+{
+    uint32_t Count;
+    uint64_t First;
+    uint64_t Last;
+    uint8_t Broken;
+} EC_jt_walk_t;
+
+/**
+ * Reports a failed expectation.
+ */
+static void EC_jt_expect(const char *Case, const char *What, uint64_t Actual, uint64_t Expected)
+{
+    if (Actual != Expected)
+    {
+        printf("FAIL %s: %s = %llu, expected %llu\n", Case, What, (unsigned long long)Actual,
+               (unsigned long long)Expected);
+        jt_failures++;
+    }
+}
+
+/**
+ * Appends the record whose content is derived from its sequence number.
+ */
+static void EC_jt_write(EC_journal_t *Journal)
+{
+    uint64_t seq = Journal->NextSeq;
+
+    EC_journal_record(Journal, (uint16_t)(seq * 7u), (uint8_t)(seq % 64u), (EC_transition_t)(seq % 4u),
+                      (EC_TIME_t)(seq * 3u), seq * 0x9E3779B97F4A7C15ull, ~seq);
+}
+
+/**
+ * Checks order and content of every recovered record.
+ */
+static void EC_jt_onRecord(void *Context, const EC_journalRecord_t *Record)
+{
+    EC_jt_walk_t *walk = (EC_jt_walk_t *)Context;
+    uint64_t seq = Record->Seq;
+
+    if ((0 != walk->Count) && (seq != walk->Last + 1))
+    {
+        walk->Broken = 1;
+    }
+    if ((Record->Source != (uint16_t)(seq * 7u)) || (Record->ErrorNumber != seq % 64u) ||
+        (Record->Transition != seq % 4u) || (Record->Tick != (uint64_t)(EC_TIME_t)(seq * 3u)) ||
+        (Record->ErrorReg != seq * 0x9E3779B97F4A7C15ull) || (Record->WarningReg != ~seq))
+    {
+        walk->Broken = 1;
+    }
+    if (0 == walk->Count)
+    {
+        walk->First = seq;
+    }
+    walk->Last = seq;
+    walk->Count++;
+}
+
+/**
+ * Recovers the journal and checks the result against the expected range.
+ */
+static void EC_jt_recover(const char *Case, const EC_journal_t *Journal, uint64_t First, uint64_t Last)
+{
+    EC_jt_walk_t walk = {0};
+    uint32_t count = EC_journal_recover(Journal, EC_jt_onRecord, &walk);
+
+    EC_jt_expect(Case, "returned count", count, walk.Count);
+    EC_jt_expect(Case, "records out of order or corrupt", walk.Broken, 0);
+    EC_jt_expect(Case, "count", walk.Count, (0 == Last) ? 0 : Last - First + 1);
+    if (walk.Count)
+    {
+        EC_jt_expect(Case, "oldest", walk.First, First);
+        EC_jt_expect(Case, "newest", walk.Last, Last);
+    }
+}
+
+/**
+ * Opens a new journal on the scratch file.
+ */
+static uint8_t EC_jt_fresh(const char *Case, EC_journal_t *Journal, uint32_t Capacity)
+{
+    unlink(jt_path);
+    if (0 != EC_journal_open(Journal, jt_path, Capacity))
+    {
+        printf("FAIL %s: open: %s\n", Case, strerror(errno));
+        jt_failures++;
+        return 0;
+    }
+
+    return 1;
+}
+
+static void EC_jt_fill(void)
+{
+    EC_journal_t journal;
+
+    if (EC_jt_fresh("fill", &journal, JT_CAPACITY))
+    {
+        EC_jt_recover("fill empty", &journal, 0, 0);
+        for (uint32_t i = 0; i < 10; i++)
+        {
+            EC_jt_write(&journal);
+        }
+        EC_jt_recover("fill", &journal, 1, 10);
+        EC_journal_close(&journal);
+    }
+}
+
+static void EC_jt_wrap(void)
+{
+    EC_journal_t journal;
+
+    if (EC_jt_fresh("wrap", &journal, JT_CAPACITY))
+    {
+        // Every ring position once as the newest record
+        for (uint32_t i = 1; i <= 5 * JT_CAPACITY + 7; i++)
+        {
+            EC_jt_write(&journal);
+            EC_jt_recover("wrap", &journal, (i > JT_CAPACITY) ? i - JT_CAPACITY + 1 : 1, i);
+        }
+        EC_journal_close(&journal);
+    }
+}
+
+static void EC_jt_reopen(void)
+{
+    EC_journal_t journal;
+
+    if (!EC_jt_fresh("reopen", &journal, JT_CAPACITY))
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        EC_jt_write(&journal);
+    }
+    EC_journal_close(&journal);
+
+    EC_jt_expect("reopen", "open with other capacity", (uint64_t)EC_journal_open(&journal, jt_path, 2 * JT_CAPACITY),
+                 (uint64_t)-1);
+    EC_jt_expect("reopen", "errno", (uint64_t)errno, EEXIST);
+
+    EC_jt_expect("reopen", "open with capacity 0", (uint64_t)EC_journal_open(&journal, jt_path, 0), 0);
+    EC_jt_expect("reopen", "NextSeq", journal.NextSeq, 101);
+    EC_jt_expect("reopen", "Capacity", journal.Header->Capacity, JT_CAPACITY);
+    EC_jt_recover("reopen", &journal, 100 - JT_CAPACITY + 1, 100);
+    EC_jt_write(&journal);
+    EC_jt_recover("reopen append", &journal, 101 - JT_CAPACITY + 1, 101);
+    EC_journal_close(&journal);
+}
+
+static void EC_jt_foreign(void)
+{
+    static const char text[] = "not a journal\n";
+    EC_journal_t journal;
+    char back[sizeof(text)] = {0};
+
+    FILE *file = fopen(jt_path, "wb");
+    if ((NULL == file) || (fwrite(text, 1, sizeof(text) - 1, file) != sizeof(text) - 1) || (0 != fclose(file)))
+    {
+        printf("FAIL foreign: cannot write %s\n", jt_path);
+        jt_failures++;
+        return;
+    }
+
+    EC_jt_expect("foreign", "open", (uint64_t)EC_journal_open(&journal, jt_path, JT_CAPACITY), (uint64_t)-1);
+    EC_jt_expect("foreign", "errno", (uint64_t)errno, EPROTO);
+    file = fopen(jt_path, "rb");
+    size_t got = (NULL != file) ? fread(back, 1, sizeof(back), file) : 0;
+    if (NULL != file)
+    {
+        fclose(file);
+    }
+    EC_jt_expect("foreign", "content kept", (got == sizeof(text) - 1) && (0 == memcmp(back, text, got)), 1);
+
+    // An empty file counts as new
+    file = fopen(jt_path, "wb");
+    if (NULL != file)
+    {
+        fclose(file);
+    }
+    EC_jt_expect("foreign", "open empty file", (uint64_t)EC_journal_open(&journal, jt_path, JT_CAPACITY), 0);
+    if (NULL != journal.Header)
+    {
+        EC_jt_recover("foreign empty", &journal, 0, 0);
+        EC_journal_close(&journal);
+    }
+}
+
+static void EC_jt_torn(void)
+{
+    for (size_t tear = 0; tear < sizeof(EC_journalRecord_t); tear++)
+    {
+        EC_journal_t journal;
+
+        if (!EC_jt_fresh("torn", &journal, JT_CAPACITY))
+        {
+            return;
+        }
+        // 3 rounds plus 9 records: the slot of seq N+1 holds seq N+1-Capacity
+        uint64_t last = 3 * JT_CAPACITY + 9;
+        for (uint64_t i = 0; i < last; i++)
+        {
+            EC_jt_write(&journal);
+        }
+
+        // Write the next record, then undo all bytes past the tear point
+        EC_journalRecord_t *slot = &journal.Records[(last + 1) % JT_CAPACITY];
+        EC_journalRecord_t old = *slot;
+        EC_jt_write(&journal);
+        memcpy((uint8_t *)slot + tear, (const uint8_t *)&old + tear, sizeof(old) - tear);
+        EC_journal_close(&journal);
+
+        EC_jt_expect("torn", "reopen", (uint64_t)EC_journal_open(&journal, jt_path, 0), 0);
+        // Without a torn byte the slot still holds its complete previous record
+        EC_jt_recover("torn", &journal, last - JT_CAPACITY + ((0 == tear) ? 1 : 2), last);
+        EC_jt_expect("torn", "NextSeq", journal.NextSeq, last + 1);
+        EC_journal_close(&journal);
+    }
+}
+
+static void EC_jt_gap(void)
+{
+    EC_journal_t journal;
+
+    if (!EC_jt_fresh("gap", &journal, JT_CAPACITY))
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < 2 * JT_CAPACITY; i++)
+    {
+        EC_jt_write(&journal);
+    }
+
+    // Corrupt one field of seq 100 - only 101..128 remain reachable
+    journal.Records[100 % JT_CAPACITY].Tick ^= 1u;
+    EC_jt_recover("gap", &journal, 101, 2 * JT_CAPACITY);
+    EC_journal_close(&journal);
+}
+
+static void EC_jt_kill(void)
+{
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    uint64_t expected_next = 1;
+
+    unlink(jt_path);
+    for (uint32_t round = 0; round < 50; round++)
+    {
+        // The child reports the last completed write through a pipe after every record
+        int fds[2];
+        if (0 != pipe(fds))
+        {
+            perror("pipe");
+            jt_failures++;
+            return;
+        }
+
+        pid_t child = fork();
+        if (0 == child)
+        {
+            EC_journal_t journal;
+
+            close(fds[0]);
+            if (0 != EC_journal_open(&journal, jt_path, JT_CAPACITY))
+            {
+                _exit(2);
+            }
+            for (;;)
+            {
+                EC_jt_write(&journal);
+                uint64_t done = journal.NextSeq - 1;
+                if (write(fds[1], &done, sizeof(done)) != (ssize_t)sizeof(done))
+                {
+                    _exit(3);
+                }
+            }
+        }
+        close(fds[1]);
+
+        rng ^= rng >> 12;
+        rng ^= rng << 25;
+        rng ^= rng >> 27;
+        struct timespec delay = {0, (long)((rng * 2685821657736338717ull) % 3000000u)};
+        nanosleep(&delay, NULL);
+        kill(child, SIGKILL);
+        waitpid(child, NULL, 0);
+
+        // Killed before the first report: the history of the previous round
+        uint64_t reported = expected_next - 1;
+        uint64_t done;
+        while (read(fds[0], &done, sizeof(done)) == (ssize_t)sizeof(done))
+        {
+            reported = done;
+        }
+        close(fds[0]);
+
+        EC_journal_t journal;
+        if (0 != EC_journal_open(&journal, jt_path, 0))
+        {
+            printf("FAIL kill: reopen: %s\n", strerror(errno));
+            jt_failures++;
+            return;
+        }
+
+        EC_jt_walk_t walk = {0};
+        EC_journal_recover(&journal, EC_jt_onRecord, &walk);
+        EC_jt_expect("kill", "records out of order or corrupt", walk.Broken, 0);
+        EC_jt_expect("kill", "history continues previous round", walk.Count ? (walk.Last >= expected_next - 1) : 1, 1);
+        // The write after the last report may or may not have completed
+        EC_jt_expect("kill", "newest covers reported write", walk.Last >= reported, 1);
+        EC_jt_expect("kill", "newest beyond a started write", walk.Last <= reported + 1, 1);
+        EC_jt_expect("kill", "count", walk.Count, (walk.Last < JT_CAPACITY) ? walk.Last : JT_CAPACITY);
+        expected_next = walk.Last + 1;
+        EC_journal_close(&journal);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static char path[512];
+
+    if (argc > 1)
+    {
+        jt_path = argv[1];
+    }
+    else
+    {
+        const char *dir = getenv("TMPDIR");
+        snprintf(path, sizeof(path), "%s/ec_journal_test.jnl", (NULL != dir) ? dir : "/tmp");
+        jt_path = path;
+    }
+
+    EC_jt_fill();
+    EC_jt_wrap();
+    EC_jt_reopen();
+    EC_jt_foreign();
+    EC_jt_torn();
+    EC_jt_gap();
+    EC_jt_kill();
+
+    unlink(jt_path);
+    printf("%s\n", jt_failures ? "FAILED" : "OK");
+
+    return jt_failures ? 1 : 0;
+}
@@ -0,0 +1,352 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file ec_log_test.c
+ * @brief Round-trip harness for the compact binary event log
+ *
+ * @details
+ * Writes 50 000 seeded transitions (all 64 error numbers, all transition
+ * kinds, tick deltas from 0 up to half the tick range, tick wrap-around)
+ * through EC_log_transition() for block sizes EC_LOG_MIN_BLOCK, 128 and 512,
+ * then decodes the log again:
+ * - roundtrip: the whole log fed in random chunks; every event must match
+ *   the written one (tick, error number, transition and both registers) and
+ *   every keyframe the state after the preceding event
+ * - bytewise: the log fed one byte at a time
+ * - split: the first blocks fed in two calls split at every byte offset,
+ *   so each record - keyframes included - is completed through the
+ *   reader's Partial buffer at every possible cut
+ * - blocks: every block decoded on its own by a fresh reader, starting at
+ *   its block boundary
+ * - boundary: the log must contain blocks filled to the last byte and blocks
+ *   closed with padding, so both block-boundary cases are exercised
+ *
+ * With a 64-bit EC_TIME_t the largest deltas exceed 2^62 ticks and are
+ * carried by the keyframe of a new block.
+ *
+ * Build: cc -std=c11 -O2 -I. tools/log/ec_log_test.c err_core_log.c err_core.c -o ec_log_test
+ *        (add -DEC_TIME_BASE_TYPE_CUSTOM=uint64_t -DEC_TIME_BASE_TYPE_CUSTOM_IS_UINT64 for a 64-bit tick)
+ * Usage: ec_log_test [seed]
+ */
+
+#include "err_core_log.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+#define LT_EVENTS 50000u
+#define LT_MAX_LOG (LT_EVENTS * 16u)
+#define LT_MAX_BLOCKS (LT_MAX_LOG / EC_LOG_MIN_BLOCK)
+#define LT_SPLIT_BLOCKS 4u
+
+/** Transition as written, with the state after it */
+typedef struct
+{
+    uint64_t Tick;
+    uint64_t ErrorReg;
+    uint64_t WarningReg;
+    EC_transition_t Transition;
+    uint8_t ErrorNumber;
+} EC_lt_event_t;
+
+/** Decoder under test and its position in the written events */
+typedef struct
+{
+    const char *Case;
+    EC_logReader_t Reader;
+    uint32_t Next;      /**< Index of the next expected event */
+    uint32_t Keyframes; /**< Keyframes decoded */
+    uint32_t Wrong;     /**< Records not matching the written ones */
+} EC_lt_rx_t;
+
+static EC_lt_event_t lt_events[LT_EVENTS];
+static uint64_t lt_init_tick;
+static uint64_t lt_init_error;
+static uint64_t lt_init_warning;
+static uint8_t lt_log[LT_MAX_LOG];
+static size_t lt_log_size;
+static uint32_t lt_block_start[LT_MAX_BLOCKS]; /**< Index of the first event of every block */
+static uint32_t lt_blocks;
+static uint32_t lt_full_blocks;
+static uint32_t lt_padded_blocks;
+static const EC_logWriter_t *lt_writer;
+static uint32_t lt_failures;
+
+/**
+ * xorshift64* step.
+ */
+static uint64_t EC_lt_random(uint64_t *State)
+{
+    *State ^= *State >> 12;
+    *State ^= *State << 25;
+    *State ^= *State >> 27;
+
+    return *State * 2685821657736338717ull;
+}
+
+/**
+ * Reports a failed expectation.
+ */
+static void EC_lt_expect(const char *Case, const char *What, uint64_t Actual, uint64_t Expected)
+{
+    if (Actual != Expected)
+    {
+        printf("FAIL %s: %s = %llu, expected %llu\n", Case, What, (unsigned long long)Actual,
+               (unsigned long long)Expected);
+        lt_failures++;
+    }
+}
+
+/**
+ * Collects emitted blocks.
+ */
+static void EC_lt_sink(void *Context, const uint8_t *Data, uint16_t Size)
+{
+    (void)Context;
+
+    if ((lt_log_size + Size > sizeof(lt_log)) || (Size != lt_writer->BlockSize))
+    {
+        printf("FAIL sink: block of %u bytes at offset %zu\n", Size, lt_log_size);
+        lt_failures++;
+        return;
+    }
+
+    // Used still holds the record bytes; the padding follows it
+    if (lt_writer->Used == Size)
+    {
+        lt_full_blocks++;
+    }
+    else
+    {
+        lt_padded_blocks++;
+    }
+
+    // The event being written when the block fills up goes to the next block
+    lt_block_start[++lt_blocks] = lt_writer->Events;
+    memcpy(&lt_log[lt_log_size], Data, Size);
+    lt_log_size += Size;
+}
+
+/**
+ * Writes the seeded transition history with the given block size.
+ */
+static void EC_lt_write(uint64_t Seed, uint16_t BlockSize)
+{
+    static uint8_t block[512];
+    static EC_instance_t instance;
+    static EC_logWriter_t writer;
+    uint64_t rng = Seed | 1u;
+    uint64_t tick_range = (uint64_t)(EC_TIME_t)-1;
+
+    memset(&writer, 0, sizeof(writer));
+    lt_writer = &writer;
+    lt_log_size = 0;
+    lt_blocks = 0;
+    lt_block_start[0] = 0;
+    lt_full_blocks = 0;
+    lt_padded_blocks = 0;
+
+    // Start shortly before the tick wraps around
+    EC_TIME_t tick = (EC_TIME_t)(tick_range - 1000u);
+    instance.ErrorReg = EC_lt_random(&rng);
+    instance.WarningReg = EC_lt_random(&rng) & ~instance.ErrorReg;
+    lt_init_tick = (uint64_t)tick;
+    lt_init_error = instance.ErrorReg;
+    lt_init_warning = instance.WarningReg;
+    EC_log_init(&writer, block, BlockSize, EC_lt_sink, NULL, &instance, tick);
+
+    uint64_t abs_tick = lt_init_tick;
+    uint64_t error_reg = lt_init_error;
+    uint64_t warning_reg = lt_init_warning;
+
+    for (uint32_t i = 0; i < LT_EVENTS; i++)
+    {
+        uint64_t pick = EC_lt_random(&rng) % 100u;
+        uint64_t delta = (pick < 70) ? EC_lt_random(&rng) % 16u
+                         : (pick < 95) ? EC_lt_random(&rng) % 1000u
+                                       : EC_lt_random(&rng) % (tick_range / 2u);
+        EC_lt_event_t *event = &lt_events[i];
+
+        event->ErrorNumber = (uint8_t)(EC_lt_random(&rng) % 64u);
+        event->Transition = (EC_transition_t)(EC_lt_random(&rng) % 4u);
+        tick = (EC_TIME_t)(tick + delta);
+        abs_tick += delta;
+        EC_transition_apply(&error_reg, &warning_reg, event->ErrorNumber, event->Transition);
+        event->Tick = abs_tick;
+        event->ErrorReg = error_reg;
+        event->WarningReg = warning_reg;
+
+        EC_log_transition(&writer, &instance, event->ErrorNumber, event->Transition, tick);
+    }
+    EC_log_flush(&writer);
+
+    EC_lt_expect("write", "Events", writer.Events, LT_EVENTS);
+}
+
+/**
+ * Checks every decoded record against the written history.
+ */
+static void EC_lt_onEvent(void *Context, const EC_logEvent_t *Event)
+{
+    EC_lt_rx_t *rx = (EC_lt_rx_t *)Context;
+    uint8_t match;
+
+    if (Event->Keyframe)
+    {
+        // A keyframe repeats the state after the last event written before it
+        uint64_t tick = rx->Next ? lt_events[rx->Next - 1].Tick : lt_init_tick;
+        uint64_t error_reg = rx->Next ? lt_events[rx->Next - 1].ErrorReg : lt_init_error;
+        uint64_t warning_reg = rx->Next ? lt_events[rx->Next - 1].WarningReg : lt_init_warning;
+
+        // A delta too large for an event record moves into the keyframe (64-bit EC_TIME_t only)
+        if ((rx->Next < LT_EVENTS) && (0 != ((lt_events[rx->Next].Tick - tick) >> 62)))
+        {
+            tick = lt_events[rx->Next].Tick;
+        }
+
+        match = (Event->Tick == tick) && (Event->ErrorReg == error_reg) && (Event->WarningReg == warning_reg);
+        rx->Keyframes++;
+    }
+    else
+    {
+        const EC_lt_event_t *expected = &lt_events[rx->Next];
+
+        match = (rx->Next < LT_EVENTS) && (Event->Tick == expected->Tick) &&
+                (Event->ErrorNumber == expected->ErrorNumber) && (Event->Transition == expected->Transition) &&
+                (Event->ErrorReg == expected->ErrorReg) && (Event->WarningReg == expected->WarningReg);
+        rx->Next++;
+    }
+
+    if (!match)
+    {
+        if (rx->Wrong < 5)
+        {
+            printf("FAIL %s: %s after event %u does not match\n", rx->Case, Event->Keyframe ? "keyframe" : "event",
+                   rx->Next);
+        }
+        rx->Wrong++;
+    }
+}
+
+/**
+ * Prepares a reader expecting the events from index First on.
+ */
+static void EC_lt_rxInit(EC_lt_rx_t *Rx, const char *Case, uint32_t First)
+{
+    memset(Rx, 0, sizeof(*Rx));
+    Rx->Case = Case;
+    Rx->Next = First;
+    EC_log_reader_init(&Rx->Reader, EC_lt_onEvent, Rx);
+}
+
+/**
+ * Checks a reader that decoded events up to index Last.
+ */
+static void EC_lt_rxExpect(const EC_lt_rx_t *Rx, uint32_t Last, uint32_t Keyframes)
+{
+    EC_lt_expect(Rx->Case, "wrong records", Rx->Wrong, 0);
+    EC_lt_expect(Rx->Case, "events decoded up to", Rx->Next, Last);
+    EC_lt_expect(Rx->Case, "keyframes", Rx->Keyframes, Keyframes);
+    EC_lt_expect(Rx->Case, "Corrupt", Rx->Reader.Corrupt, 0);
+    EC_lt_expect(Rx->Case, "PartialLen at end", Rx->Reader.PartialLen, 0);
+}
+
+/**
+ * Decodes the whole log fed in chunks of 1..MaxChunk bytes.
+ */
+static void EC_lt_roundtrip(const char *Case, uint64_t Seed, size_t MaxChunk)
+{
+    EC_lt_rx_t rx;
+    uint64_t rng = Seed ^ 0x5A5A5A5A5A5A5A5Aull;
+
+    EC_lt_rxInit(&rx, Case, 0);
+    for (size_t pos = 0; pos < lt_log_size;)
+    {
+        size_t chunk = 1 + EC_lt_random(&rng) % MaxChunk;
+        chunk = (chunk < lt_log_size - pos) ? chunk : lt_log_size - pos;
+        EC_log_reader_feed(&rx.Reader, &lt_log[pos], chunk);
+        pos += chunk;
+    }
+    EC_lt_rxExpect(&rx, LT_EVENTS, lt_blocks);
+}
+
+/**
+ * Feeds the first blocks in two calls, split at every byte offset.
+ */
+static void EC_lt_split(uint16_t BlockSize)
+{
+    uint32_t blocks = (lt_blocks < LT_SPLIT_BLOCKS) ? lt_blocks : LT_SPLIT_BLOCKS;
+    size_t size = (size_t)blocks * BlockSize;
+
+    for (size_t cut = 0; cut <= size; cut++)
+    {
+        EC_lt_rx_t rx;
+
+        EC_lt_rxInit(&rx, "split", 0);
+        EC_log_reader_feed(&rx.Reader, lt_log, cut);
+        EC_log_reader_feed(&rx.Reader, &lt_log[cut], size - cut);
+        EC_lt_rxExpect(&rx, lt_block_start[blocks], blocks);
+        if (rx.Wrong || rx.Reader.Corrupt)
+        {
+            printf("FAIL split: cut at byte %zu\n", cut);
+            return;
+        }
+    }
+}
+
+/**
+ * Decodes every block on its own, starting at its block boundary.
+ */
+static void EC_lt_blocks(uint16_t BlockSize)
+{
+    for (uint32_t b = 0; b < lt_blocks; b++)
+    {
+        EC_lt_rx_t rx;
+
+        EC_lt_rxInit(&rx, "blocks", lt_block_start[b]);
+        EC_log_reader_feed(&rx.Reader, &lt_log[(size_t)b * BlockSize], BlockSize);
+        EC_lt_rxExpect(&rx, lt_block_start[b + 1], 1);
+        if (rx.Wrong || rx.Reader.Corrupt)
+        {
+            printf("FAIL blocks: block %u\n", b);
+            return;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static const uint16_t block_sizes[] = {EC_LOG_MIN_BLOCK, 128, 512};
+    uint64_t seed = (argc > 1) ? strtoull(argv[1], NULL, 0) : 1;
+
+    for (size_t i = 0; i < sizeof(block_sizes) / sizeof(block_sizes[0]); i++)
+    {
+        uint16_t block_size = block_sizes[i];
+
+        EC_lt_write(seed + i, block_size);
+        printf("block %3u: %u events, %u blocks (%u full, %u padded), %.2f bytes per event\n", block_size,
+               LT_EVENTS, lt_blocks, lt_full_blocks, lt_padded_blocks, (double)lt_log_size / LT_EVENTS);
+
+        EC_lt_expect("write", "log size", lt_log_size, (size_t)lt_blocks * block_size);
+        EC_lt_expect("write", "last block ends at last event", lt_block_start[lt_blocks], LT_EVENTS);
+        EC_lt_expect("boundary", "blocks filled to the last byte", lt_full_blocks > 0, 1);
+        EC_lt_expect("boundary", "blocks closed with padding", lt_padded_blocks > 0, 1);
+
+        EC_lt_roundtrip("roundtrip", seed + i, 2u * block_size);
+        EC_lt_roundtrip("bytewise", seed + i, 1);
+        EC_lt_split(block_size);
+        EC_lt_blocks(block_size);
+    }
+
+    printf("%s\n", lt_failures ? "FAILED" : "OK");
+
+    return lt_failures ? 1 : 0;
+}
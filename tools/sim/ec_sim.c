@@ -0,0 +1,247 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+#include "ec_sim.h"
+#include "assert.h"
+#include "string.h"
+
+#define EC_SIM_NEVER UINT64_MAX
+
+static EC_sim_t *sim_current;
+static EC_TIME_t sim_tick;
+
+#if EC_TICK_FROM_FUNC
+static EC_TIME_t EC_sim_getTick(void)
+{
+    return sim_tick;
+}
+#endif
+
+/**
+ * ErrFunc of simulated errors.
+ */
+EC_err_state_t EC_sim_check(uint16_t HelperNumber)
+{
+    assert(sim_current != NULL);
+    assert(HelperNumber < 64);
+
+    return sim_current->Errors[HelperNumber].Present ? EC_ERR : EC_NERR;
+}
+
+/**
+ * xorshift64* - uniform value in [1, 2 * Mean].
+ */
+static uint64_t EC_sim_random(uint64_t *State, uint64_t Mean)
+{
+    uint64_t x = *State;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *State = x;
+
+    return 1u + ((x * 2685821657736338717ull) >> 11) % (2u * (Mean ? Mean : 1u));
+}
+
+/**
+ * Returns the tick of the presence change following one at Edge.
+ */
+static uint64_t EC_sim_following(EC_simError_t *Error, uint64_t Edge)
+{
+    const EC_simWave_t *wave = &Error->Wave;
+
+    switch (wave->Shape)
+    {
+    case EC_SIM_PERIODIC:
+        if (wave->On >= wave->Period)
+        {
+            return EC_SIM_NEVER;
+        }
+        return Edge + (Error->Present ? wave->On : (wave->Period - wave->On));
+
+    case EC_SIM_BURST:
+        return Edge + EC_sim_random(&Error->Rng, Error->Present ? wave->On : wave->Period);
+
+    default:
+        return EC_SIM_NEVER;
+    }
+}
+
+/**
+ * Prepares a simulation at tick 0.
+ */
+void EC_sim_init(EC_sim_t *Sim, EC_instance_t *Instance, const EC_simWave_t *Waves)
+{
+    assert(Sim != NULL);
+    assert(Instance != NULL);
+    assert(Waves != NULL);
+
+    memset(Sim, 0, sizeof(*Sim));
+    Sim->Instance = Instance;
+
+    for (uint8_t i = 0; i < Instance->NumberOfErrors; i++)
+    {
+        EC_simError_t *error = &Sim->Errors[i];
+
+        assert(Instance->Errors[i].HelperNumber == i);
+
+        error->Wave = Waves[i];
+        error->Rng = Waves[i].Seed | 1u;
+        error->FirstWarning = EC_SIM_NEVER;
+        error->FirstError = EC_SIM_NEVER;
+        error->NextEdge = (EC_SIM_ABSENT == Waves[i].Shape) ||
+                                  ((EC_SIM_PERIODIC == Waves[i].Shape) && (0 == Waves[i].On))
+                              ? EC_SIM_NEVER
+                              : Waves[i].Start;
+    }
+
+    sim_tick = 0;
+#if EC_TICK_FROM_FUNC
+    EC_tick_function_register(EC_sim_getTick);
+#else
+    EC_tick_variable_register(&sim_tick);
+#endif
+}
+
+/**
+ * Earliest tick after Now at which a poll can change the state of error I.
+ */
+static uint64_t EC_sim_nextEvent(const EC_sim_t *Sim, uint8_t I, uint64_t Now)
+{
+    const EC_instance_t *instance = Sim->Instance;
+    const EC_error_t *config = &instance->Errors[I];
+    const EC_runtimeData_t *runtime = &instance->RuntimeData[I];
+    const EC_simError_t *error = &Sim->Errors[I];
+    uint64_t next = EC_SIM_NEVER;
+
+    if (instance->ErrorReg & ((uint64_t)1 << I))
+    {
+        // Latched - ErrFunc is not called and the reset path has nothing left to clear
+        return next;
+    }
+
+    // Presence edge and the last tick before it (fixes LastNoErr exactly as per-tick polling)
+    if (EC_SIM_NEVER != error->NextEdge)
+    {
+        next = (error->NextEdge - 1u > Now) ? (error->NextEdge - 1u) : error->NextEdge;
+    }
+
+    // Reset deadline
+    uint64_t reset = EC_SIM_NEVER;
+    EC_TIME_t since_reg = (EC_TIME_t)((EC_TIME_t)Now - runtime->LastReg);
+    if (since_reg < config->TimeToResetWarning)
+    {
+        reset = Now + (EC_TIME_t)(config->TimeToResetWarning - since_reg);
+        next = (reset < next) ? reset : next;
+    }
+
+    // Debounce deadline of a present condition
+    if (error->Present)
+    {
+        uint64_t fire;
+
+        if (runtime->WarningPending)
+        {
+            // Re-armed by the reset, fires on the poll after it
+            fire = (EC_SIM_NEVER != reset) ? (reset + 1u) : (Now + 1u);
+        }
+        else
+        {
+            EC_TIME_t since_absent = (EC_TIME_t)((EC_TIME_t)Now - runtime->LastNoErr);
+            fire = (since_absent < config->TimeToErrorRegister)
+                       ? (Now + (EC_TIME_t)(config->TimeToErrorRegister - since_absent))
+                       : (Now + 1u);
+        }
+        next = (fire < next) ? fire : next;
+    }
+
+    return next;
+}
+
+/**
+ * Polls once at Sim->Tick and records registrations.
+ */
+static void EC_sim_poll(EC_sim_t *Sim)
+{
+    EC_instance_t *instance = Sim->Instance;
+    uint64_t error_reg = instance->ErrorReg;
+    uint64_t warning_reg = instance->WarningReg;
+    uint8_t warning_cnt[64];
+
+    for (uint8_t i = 0; i < instance->NumberOfErrors; i++)
+    {
+        EC_simError_t *error = &Sim->Errors[i];
+
+        while (error->NextEdge <= Sim->Tick)
+        {
+            error->Present = !error->Present;
+            error->NextEdge = EC_sim_following(error, error->NextEdge);
+        }
+        warning_cnt[i] = instance->RuntimeData[i].WarningCnt;
+    }
+
+    sim_tick = (EC_TIME_t)Sim->Tick;
+    EC_poll(instance);
+    Sim->Polls++;
+
+    for (uint8_t i = 0; i < instance->NumberOfErrors; i++)
+    {
+        EC_simError_t *error = &Sim->Errors[i];
+        uint64_t bit = (uint64_t)1 << i;
+        uint8_t changed = 0;
+
+        if (instance->RuntimeData[i].WarningCnt > warning_cnt[i])
+        {
+            error->Warnings++;
+            error->FirstWarning = (EC_SIM_NEVER == error->FirstWarning) ? Sim->Tick : error->FirstWarning;
+            changed = 1;
+        }
+        if ((instance->ErrorReg & bit) && !(error_reg & bit))
+        {
+            error->Errors++;
+            error->FirstError = (EC_SIM_NEVER == error->FirstError) ? Sim->Tick : error->FirstError;
+            changed = 1;
+        }
+        changed |= ((instance->WarningReg ^ warning_reg) & bit) ||
+                   (instance->RuntimeData[i].WarningCnt != warning_cnt[i]);
+
+        if (changed && (NULL != Sim->OnChange))
+        {
+            Sim->OnChange(Sim->Context, Sim, i);
+        }
+    }
+}
+
+/**
+ * Runs the simulation up to and including Until.
+ */
+void EC_sim_run(EC_sim_t *Sim, uint64_t Until, uint8_t EveryTick)
+{
+    assert(Sim != NULL);
+
+    sim_current = Sim;
+
+    while (Sim->Tick < Until)
+    {
+        uint64_t next = Sim->Tick + 1u;
+
+        if (!EveryTick)
+        {
+            next = Until;
+            for (uint8_t i = 0; i < Sim->Instance->NumberOfErrors; i++)
+            {
+                uint64_t event = EC_sim_nextEvent(Sim, i, Sim->Tick);
+                next = (event < next) ? event : next;
+            }
+        }
+
+        Sim->Tick = next;
+        EC_sim_poll(Sim);
+    }
+}
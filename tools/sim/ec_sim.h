@@ -0,0 +1,134 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file ec_sim.h
+ * @brief Error Core - Deterministic virtual-clock simulator (host tool)
+ *
+ * @details
+ * Drives an instance with a virtual tick and scripted presence waveforms per
+ * error. Instead of polling on every tick, the simulator jumps straight to
+ * the next tick at which EC_poll() can change state:
+ * - the last absent tick before a presence edge and the edge itself
+ * - the debounce deadline LastNoErr + TimeToErrorRegister of a present error
+ * - the reset deadline LastReg + TimeToResetWarning
+ *
+ * Between those ticks a per-tick poll only refreshes LastNoErr of absent
+ * errors, which is overwritten again before it is read. Registers, warning
+ * counters and registration ticks are therefore identical to polling on
+ * every tick; EC_sim_run() with EveryTick = 1 does exactly that and serves
+ * as the cross-check.
+ *
+ * The error table must use EC_sim_check() as ErrFunc with HelperNumber equal
+ * to the error index. Only one simulation runs at a time (ErrFunc has no
+ * context pointer).
+ */
+
+#ifndef ERR_CORE_TOOLS_EC_SIM_H_
+#define ERR_CORE_TOOLS_EC_SIM_H_
+
+#include "err_core.h"
+
+/*******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/**
+ * @enum EC_simShape_t
+ * @brief Presence waveform shapes
+ */
+typedef enum
+{
+    EC_SIM_ABSENT = 0,   /**< Never present */
+    EC_SIM_STUCK = 1,    /**< Present from Start on */
+    EC_SIM_PERIODIC = 2, /**< Present for On ticks every Period ticks, first rise at Start */
+    EC_SIM_BURST = 3     /**< Random bursts: gaps and lengths uniform in [1, 2 * mean] */
+} EC_simShape_t;
+
+/**
+ * @struct EC_simWave_t
+ * @brief Presence waveform of one error
+ */
+typedef struct
+{
+    EC_simShape_t Shape; /**< Waveform shape */
+    uint64_t Start;      /**< First rising edge */
+    uint64_t Period;     /**< PERIODIC: period; BURST: mean gap */
+    uint64_t On;         /**< PERIODIC: present time per period; BURST: mean burst length */
+    uint64_t Seed;       /**< BURST: PRNG seed */
+} EC_simWave_t;
+
+/**
+ * @struct EC_simError_t
+ * @brief Per-error simulation state and results
+ */
+typedef struct
+{
+    EC_simWave_t Wave;     /**< Waveform */
+    uint64_t NextEdge;     /**< Tick of the next presence change (UINT64_MAX = none) */
+    uint64_t Rng;          /**< BURST PRNG state */
+    uint8_t Present;       /**< Presence at the current tick */
+
+    uint64_t FirstWarning; /**< Tick of the first warning (UINT64_MAX = none) */
+    uint64_t FirstError;   /**< Tick of the error registration (UINT64_MAX = none) */
+    uint32_t Warnings;     /**< Number of warnings registered */
+    uint32_t Errors;       /**< Number of errors registered */
+} EC_simError_t;
+
+/**
+ * @struct EC_sim_t
+ * @brief Simulation of one instance
+ */
+typedef struct EC_sim_s
+{
+    EC_instance_t *Instance;  /**< Simulated instance */
+    EC_simError_t Errors[64]; /**< Per-error waveform and results */
+    uint64_t Tick;            /**< Current virtual tick */
+    uint64_t Polls;           /**< Number of EC_poll() calls */
+
+    /**
+     * @brief Optional change callback, called after every poll that changed
+     *        ErrorReg, WarningReg or a warning counter of ErrorNumber
+     */
+    void (*OnChange)(void *Context, const struct EC_sim_s *Sim, uint8_t ErrorNumber);
+    void *Context; /**< User pointer passed to OnChange */
+} EC_sim_t;
+
+/*******************************************************************************
+ * FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/**
+ * @brief ErrFunc for simulated errors (HelperNumber = error index)
+ */
+EC_err_state_t EC_sim_check(uint16_t HelperNumber);
+
+/**
+ * @brief Prepares a simulation
+ *
+ * Registers the virtual tick as tick source and starts at tick 0. The
+ * instance must be initialized with EC_init() and use EC_sim_check().
+ *
+ * @param[out] Sim      Simulation
+ * @param[in]  Instance Instance to drive
+ * @param[in]  Waves    One waveform per error
+ */
+void EC_sim_init(EC_sim_t *Sim, EC_instance_t *Instance, const EC_simWave_t *Waves);
+
+/**
+ * @brief Runs the simulation up to and including tick Until
+ *
+ * @param[in,out] Sim       Simulation
+ * @param[in]     Until     Last tick to simulate
+ * @param[in]     EveryTick 1 = poll on every tick (reference), 0 = poll at state-changing ticks only
+ */
+void EC_sim_run(EC_sim_t *Sim, uint64_t Until, uint8_t EveryTick);
+
+#endif /* ERR_CORE_TOOLS_EC_SIM_H_ */
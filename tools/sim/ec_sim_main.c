@@ -0,0 +1,173 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file ec_sim_main.c
+ * @brief Scenario runner for the virtual-clock simulator
+ *
+ * @details
+ * Runs the built-in scenarios and checks their registration ticks against
+ * values derived from the debounce rules:
+ * - periodic: a presence longer than TimeToErrorRegister registers a warning
+ *   TimeToErrorRegister ticks after its last absent tick, the
+ *   WarningsToError-th one registers the error
+ * - stuck: one warning, re-armed by every TimeToResetWarning timeout, never
+ *   escalates because the timeout also resets WarningCnt
+ * - day: 64 mixed waveforms for 24 h at 1 kHz, reports the simulation speed
+ *
+ * With --verify every scenario additionally runs with a poll on every tick
+ * and the per-error results must match exactly.
+ *
+ * Build: cc -std=c11 -O2 -I. tools/sim/ec_sim.c tools/sim/ec_sim_main.c err_core.c -o ec_sim
+ * Usage: ec_sim [--verify]
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "ec_sim.h"
+#include "stdio.h"
+#include "string.h"
+#include "time.h"
+
+#define EC_SIM_DAY_1KHZ 86400000u
+
+static uint32_t sim_failures;
+
+/**
+ * Reports a failed expectation.
+ */
+static void EC_sim_expect(const char *Scenario, const char *What, uint64_t Actual, uint64_t Expected)
+{
+    if (Actual != Expected)
+    {
+        printf("FAIL %s: %s = %llu, expected %llu\n", Scenario, What, (unsigned long long)Actual,
+               (unsigned long long)Expected);
+        sim_failures++;
+    }
+}
+
+static double EC_sim_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Runs a scenario event-driven and, with Verify, per tick; compares both.
+ */
+static void EC_sim_scenario(const char *Name, const EC_error_t *Errors, const EC_simWave_t *Waves, uint8_t Count,
+                            uint64_t Until, uint8_t Verify, EC_simError_t *Results)
+{
+    static EC_runtimeData_t runtime[64];
+    static EC_sim_t sim;
+    static EC_sim_t reference;
+    EC_instance_t instance = {0};
+
+    memset(runtime, 0, sizeof(runtime));
+    EC_init(&instance, Errors, runtime, Count);
+    EC_sim_init(&sim, &instance, Waves);
+
+    double start = EC_sim_seconds();
+    EC_sim_run(&sim, Until, 0);
+    double elapsed = EC_sim_seconds() - start;
+
+    printf("%-10s %llu ticks x %u errors: %llu polls, %.3f s\n", Name, (unsigned long long)Until, Count,
+           (unsigned long long)sim.Polls, elapsed);
+    memcpy(Results, sim.Errors, sizeof(sim.Errors));
+
+    if (!Verify)
+    {
+        return;
+    }
+
+    EC_instance_t shadow = {0};
+    memset(runtime, 0, sizeof(runtime));
+    EC_init(&shadow, Errors, runtime, Count);
+    EC_sim_init(&reference, &shadow, Waves);
+    EC_sim_run(&reference, Until, 1);
+
+    EC_sim_expect(Name, "ErrorReg vs per-tick", instance.ErrorReg, shadow.ErrorReg);
+    EC_sim_expect(Name, "WarningReg vs per-tick", instance.WarningReg, shadow.WarningReg);
+    for (uint8_t i = 0; i < Count; i++)
+    {
+        EC_sim_expect(Name, "Warnings vs per-tick", sim.Errors[i].Warnings, reference.Errors[i].Warnings);
+        EC_sim_expect(Name, "FirstWarning vs per-tick", sim.Errors[i].FirstWarning, reference.Errors[i].FirstWarning);
+        EC_sim_expect(Name, "FirstError vs per-tick", sim.Errors[i].FirstError, reference.Errors[i].FirstError);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t verify = (argc > 1) && (0 == strcmp(argv[1], "--verify"));
+    static EC_simError_t results[64];
+    EC_error_t errors[64];
+    EC_simWave_t waves[64];
+
+    // Periodic: present 300 of every 1000 ticks from tick 500, debounce 100, 3 warnings to error
+    errors[0] = (EC_error_t){EC_sim_check, 0, 100, 5000, 3};
+    waves[0] = (EC_simWave_t){EC_SIM_PERIODIC, 500, 1000, 300, 0};
+    // Same, but presences shorter than the debounce time never register
+    errors[1] = (EC_error_t){EC_sim_check, 1, 100, 5000, 3};
+    waves[1] = (EC_simWave_t){EC_SIM_PERIODIC, 500, 1000, 99, 0};
+    EC_sim_scenario("periodic", errors, waves, 2, 100000, verify, results);
+    EC_sim_expect("periodic", "FirstWarning[0]", results[0].FirstWarning, 500 - 1 + 100);
+    EC_sim_expect("periodic", "FirstError[0]", results[0].FirstError, 500 + 2 * 1000 - 1 + 100);
+    EC_sim_expect("periodic", "Warnings[0]", results[0].Warnings, 2);
+    EC_sim_expect("periodic", "Warnings[1]", results[1].Warnings, 0);
+
+    // Stuck from tick 10000: warning after 50 ticks, re-armed every 200 + 1 ticks
+    errors[0] = (EC_error_t){EC_sim_check, 0, 50, 200, 3};
+    waves[0] = (EC_simWave_t){EC_SIM_STUCK, 10000, 0, 0, 0};
+    EC_sim_scenario("stuck", errors, waves, 1, 60000, verify, results);
+    EC_sim_expect("stuck", "FirstWarning", results[0].FirstWarning, 10000 - 1 + 50);
+    EC_sim_expect("stuck", "Warnings", results[0].Warnings, (60000 - 10049) / 201 + 1);
+    EC_sim_expect("stuck", "Errors", results[0].Errors, 0);
+
+    // Random bursts, cross-checked per tick only
+    for (uint8_t i = 0; i < 64; i++)
+    {
+        errors[i] = (EC_error_t){EC_sim_check, i, (EC_TIME_t)(5 + i), (EC_TIME_t)(50 + 3 * i), (uint16_t)(2 + i % 4)};
+        waves[i] = (EC_simWave_t){EC_SIM_BURST, 1 + i, 40 + i, 10 + i % 20, 0x9E3779B97F4A7C15ull * (i + 1u)};
+    }
+    if (verify)
+    {
+        EC_sim_scenario("bursts", errors, waves, 64, 2000000, verify, results);
+    }
+
+    // One day at 1 kHz, 64 errors: stuck, periodic and bursty inputs
+    for (uint8_t i = 0; i < 64; i++)
+    {
+        errors[i] = (EC_error_t){EC_sim_check, i, 200, 60000, 5};
+        switch (i % 4)
+        {
+        case 0:
+            waves[i] = (EC_simWave_t){EC_SIM_ABSENT, 0, 0, 0, 0};
+            break;
+        case 1:
+            waves[i] = (EC_simWave_t){EC_SIM_STUCK, 3600000u * (i % 24u), 0, 0, 0};
+            break;
+        case 2:
+            waves[i] = (EC_simWave_t){EC_SIM_PERIODIC, 1000u * i, 60000u + 1000u * i, 5000, 0};
+            break;
+        default:
+            waves[i] = (EC_simWave_t){EC_SIM_BURST, 0, 30000, 400, 0xD1B54A32D192ED03ull * (i + 1u)};
+            break;
+        }
+    }
+    EC_sim_scenario("day", errors, waves, 64, EC_SIM_DAY_1KHZ, 0, results);
+
+    printf("%s\n", sim_failures ? "FAILED" : "OK");
+
+    return sim_failures ? 1 : 0;
+}
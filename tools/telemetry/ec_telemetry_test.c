@@ -0,0 +1,377 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Author: Adrian Pietrzak
+ * GitHub: https://github.com/AdrianPietrzak1998
+ * Created: Oct 16, 2026
+ */
+
+/**
+ * @file ec_telemetry_test.c
+ * @brief Pipe round-trip harness for the delta telemetry encoder and decoder
+ *
+ * @details
+ * Encodes a seeded register history of four sources (1, 7, 24 and 64 errors)
+ * into one byte stream. A child process writes the stream into a pipe in
+ * random-sized chunks, the parent reads it in random-sized chunks and feeds
+ * the decoders. Every applied frame is matched against the encoder side by
+ * source and sequence number and must carry exactly the registers the
+ * encoder saw.
+ *
+ * Cases:
+ * - clean: every frame applied, no corrupt, lost or unsynced frames
+ * - corrupt: bit flips, dropped bytes, inserted bytes and spurious 0x00
+ *   delimiters in the first 80 % of the stream; no wrong state may be
+ *   applied and every source must be back in sync at the end
+ * - join: decoders starting at random offsets (mid-frame); deltas before the
+ *   first keyframe of a source are dropped, afterwards the state is exact
+ *
+ * Build: cc -std=c11 -O2 -I. tools/telemetry/ec_telemetry_test.c err_core_telemetry.c err_core.c -o ec_telemetry_test
+ * Usage: ec_telemetry_test [seed]
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "err_core_telemetry.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "sys/wait.h"
+#include "unistd.h"
+
+#define TT_SOURCES 4u
+#define TT_PERIODS 20000u
+#define TT_KEYFRAME_INTERVAL 25u
+#define TT_JOINS 16u
+#define TT_MAX_FRAMES (TT_SOURCES * TT_PERIODS)
+
+/** Frame as produced by the encoder */
+typedef struct
+{
+    uint64_t ErrorReg;
+    uint64_t WarningReg;
+    uint8_t Source;
+    uint8_t Seq;
+    uint8_t Keyframe;
+    size_t Offset; /**< Start of the frame in the clean stream */
+} EC_tt_frame_t;
+
+/** One decoder under test and its position in the expected frames */
+typedef struct
+{
+    const char *Case;
+    EC_telemetryDecoder_t Decoder;
+    EC_telemetrySource_t Sources[TT_SOURCES];
+    uint32_t Cursor[TT_SOURCES];   /**< Next expected frame index per source */
+    uint8_t Applied[TT_SOURCES];   /**< At least one frame applied */
+    uint32_t Wrong;                /**< Applied frames not matching the encoder */
+    uint32_t FirstNotKeyframe;     /**< Sources whose first applied frame was a delta */
+} EC_tt_rx_t;
+
+static const uint8_t tt_errors[TT_SOURCES] = {1, 7, 24, 64};
+
+static EC_tt_frame_t tt_frames[TT_MAX_FRAMES];
+static uint32_t tt_num_frames;
+static uint32_t tt_by_source[TT_SOURCES][TT_PERIODS];
+static uint32_t tt_source_frames[TT_SOURCES];
+static uint64_t tt_final_error[TT_SOURCES];
+static uint64_t tt_final_warning[TT_SOURCES];
+static uint8_t tt_stream[TT_MAX_FRAMES * EC_TELEMETRY_MAX_FRAME];
+static size_t tt_stream_size;
+static uint32_t tt_failures;
+
+/**
+ * xorshift64* step.
+ */
+static uint64_t EC_tt_random(uint64_t *State)
+{
+    *State ^= *State >> 12;
+    *State ^= *State << 25;
+    *State ^= *State >> 27;
+
+    return *State * 2685821657736338717ull;
+}
+
+/**
+ * Reports a failed expectation.
+ */
+static void EC_tt_expect(const char *Case, const char *What, uint64_t Actual, uint64_t Expected)
+{
+    if (Actual != Expected)
+    {
+        printf("FAIL %s: %s = %llu, expected %llu\n", Case, What, (unsigned long long)Actual,
+               (unsigned long long)Expected);
+        tt_failures++;
+    }
+}
+
+/**
+ * Encodes the seeded register history of all sources into tt_stream.
+ */
+static void EC_tt_generate(uint64_t Seed)
+{
+    static EC_error_t errors[64];
+    static EC_runtimeData_t runtime[TT_SOURCES][64];
+    EC_instance_t instances[TT_SOURCES];
+    EC_telemetryEncoder_t encoders[TT_SOURCES];
+    uint64_t rng = Seed | 1u;
+
+    memset(instances, 0, sizeof(instances));
+    for (uint8_t s = 0; s < TT_SOURCES; s++)
+    {
+        EC_init(&instances[s], errors, runtime[s], tt_errors[s]);
+        EC_telemetry_encoder_init(&encoders[s], s, TT_KEYFRAME_INTERVAL);
+    }
+
+    for (uint32_t period = 0; period < TT_PERIODS; period++)
+    {
+        for (uint8_t s = 0; s < TT_SOURCES; s++)
+        {
+            EC_instance_t *instance = &instances[s];
+            uint64_t valid = EC_ALL_ERRORS_MASK(instance->NumberOfErrors);
+            uint64_t pick = EC_tt_random(&rng) % 10u;
+
+            // Registers are driven directly: the encoder only reads them
+            if (pick < 3)
+            {
+                instance->ErrorReg ^= ((uint64_t)1 << (EC_tt_random(&rng) % instance->NumberOfErrors));
+                instance->WarningReg ^= (EC_tt_random(&rng) & 1u) << (EC_tt_random(&rng) % instance->NumberOfErrors);
+            }
+            else if (pick < 4)
+            {
+                instance->ErrorReg ^= EC_tt_random(&rng) & valid;
+                instance->WarningReg ^= EC_tt_random(&rng) & valid;
+            }
+
+            EC_tt_frame_t *frame = &tt_frames[tt_num_frames];
+            frame->Seq = encoders[s].Seq;
+            size_t len = EC_telemetry_encode(&encoders[s], instance, &tt_stream[tt_stream_size], EC_TELEMETRY_MAX_FRAME);
+            if (len)
+            {
+                frame->ErrorReg = instance->ErrorReg;
+                frame->WarningReg = instance->WarningReg;
+                frame->Source = s;
+                frame->Keyframe = (0 == encoders[s].SinceKeyframe);
+                frame->Offset = tt_stream_size;
+                tt_by_source[s][tt_source_frames[s]++] = tt_num_frames++;
+                tt_stream_size += len;
+            }
+        }
+    }
+
+    for (uint8_t s = 0; s < TT_SOURCES; s++)
+    {
+        tt_final_error[s] = instances[s].ErrorReg;
+        tt_final_warning[s] = instances[s].WarningReg;
+    }
+}
+
+/**
+ * Matches an applied frame against the encoder side.
+ */
+static void EC_tt_onFrame(void *Context, const EC_telemetryFrame_t *Frame)
+{
+    EC_tt_rx_t *rx = (EC_tt_rx_t *)Context;
+    uint8_t s = Frame->Source;
+
+    // Lost frames only skip forward; sequence numbers repeat every 256 frames of a source
+    uint32_t i = rx->Cursor[s];
+    while ((i < tt_source_frames[s]) && (i - rx->Cursor[s] < 256u) && (tt_frames[tt_by_source[s][i]].Seq != Frame->Seq))
+    {
+        i++;
+    }
+
+    const EC_tt_frame_t *expected = (i < tt_source_frames[s]) ? &tt_frames[tt_by_source[s][i]] : NULL;
+    if ((NULL == expected) || (expected->Seq != Frame->Seq) || (expected->ErrorReg != Frame->ErrorReg) ||
+        (expected->WarningReg != Frame->WarningReg) || (expected->Keyframe != Frame->Keyframe) ||
+        (tt_errors[s] != Frame->NumberOfErrors))
+    {
+        if (rx->Wrong < 5)
+        {
+            printf("FAIL %s: source %u seq %u: wrong state applied\n", rx->Case, s, Frame->Seq);
+        }
+        rx->Wrong++;
+        return;
+    }
+
+    if (!rx->Applied[s] && !Frame->Keyframe)
+    {
+        rx->FirstNotKeyframe++;
+    }
+    rx->Applied[s] = 1;
+    rx->Cursor[s] = i + 1;
+}
+
+/**
+ * Prepares a decoder whose expected frames start at stream offset Offset.
+ */
+static void EC_tt_rxInit(EC_tt_rx_t *Rx, const char *Case, size_t Offset)
+{
+    memset(Rx, 0, sizeof(*Rx));
+    Rx->Case = Case;
+    EC_telemetry_decoder_init(&Rx->Decoder, Rx->Sources, TT_SOURCES, EC_tt_onFrame, Rx);
+
+    for (uint8_t s = 0; s < TT_SOURCES; s++)
+    {
+        while ((Rx->Cursor[s] < tt_source_frames[s]) && (tt_frames[tt_by_source[s][Rx->Cursor[s]]].Offset < Offset))
+        {
+            Rx->Cursor[s]++;
+        }
+    }
+}
+
+/**
+ * Writes the stream into the pipe, optionally corrupted, in random chunks.
+ */
+static void EC_tt_writer(int Fd, uint64_t Seed, uint8_t Corrupt)
+{
+    static uint8_t out[sizeof(tt_stream) + sizeof(tt_stream) / 64u];
+    size_t used = 0;
+    size_t corrupt_end = Corrupt ? tt_stream_size * 8u / 10u : 0;
+    uint64_t rng = Seed ^ 0xA5A5A5A5A5A5A5A5ull;
+
+    for (size_t i = 0; i < tt_stream_size; i++)
+    {
+        uint8_t byte = tt_stream[i];
+
+        if ((i < corrupt_end) && (0 == EC_tt_random(&rng) % 400u))
+        {
+            switch (EC_tt_random(&rng) % 4u)
+            {
+            case 0:
+                byte ^= (uint8_t)(1u << (EC_tt_random(&rng) % 8u));
+                break;
+            case 1:
+                continue;
+            case 2:
+                out[used++] = (uint8_t)EC_tt_random(&rng);
+                break;
+            default:
+                out[used++] = 0;
+                break;
+            }
+        }
+        out[used++] = byte;
+    }
+
+    for (size_t pos = 0; pos < used;)
+    {
+        size_t chunk = 1 + EC_tt_random(&rng) % 300u;
+        ssize_t written = write(Fd, &out[pos], (chunk < used - pos) ? chunk : used - pos);
+        if (written <= 0)
+        {
+            _exit(3);
+        }
+        pos += (size_t)written;
+    }
+}
+
+/**
+ * Runs one case: child writes the stream, parent reads and decodes it.
+ */
+static void EC_tt_run(EC_tt_rx_t *Rx, uint32_t NumRx, const size_t *Offsets, uint64_t Seed, uint8_t Corrupt)
+{
+    int fds[2];
+    if (0 != pipe(fds))
+    {
+        perror("pipe");
+        exit(2);
+    }
+
+    pid_t child = fork();
+    if (0 == child)
+    {
+        close(fds[0]);
+        EC_tt_writer(fds[1], Seed, Corrupt);
+        _exit(0);
+    }
+    close(fds[1]);
+
+    static uint8_t chunk[257];
+    uint64_t rng = Seed ^ 0x5A5A5A5A5A5A5A5Aull;
+    size_t received = 0;
+    ssize_t got;
+
+    while ((got = read(fds[0], chunk, 1 + EC_tt_random(&rng) % sizeof(chunk))) > 0)
+    {
+        for (uint32_t r = 0; r < NumRx; r++)
+        {
+            // A decoder joining mid-stream sees only the bytes from its offset on
+            size_t skip = (Offsets[r] > received) ? Offsets[r] - received : 0;
+            if (skip < (size_t)got)
+            {
+                EC_telemetry_decoder_feed(&Rx[r].Decoder, &chunk[skip], (size_t)got - skip);
+            }
+        }
+        received += (size_t)got;
+    }
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    EC_tt_expect(Rx[0].Case, "writer exit status", (uint64_t)status, 0);
+}
+
+/**
+ * Checks that every source ends with the final encoder state.
+ */
+static void EC_tt_expectFinal(const EC_tt_rx_t *Rx)
+{
+    for (uint8_t s = 0; s < TT_SOURCES; s++)
+    {
+        EC_tt_expect(Rx->Case, "source synced at end", Rx->Sources[s].Synced, 1);
+        EC_tt_expect(Rx->Case, "final ErrorReg", Rx->Sources[s].ErrorReg, tt_final_error[s]);
+        EC_tt_expect(Rx->Case, "final WarningReg", Rx->Sources[s].WarningReg, tt_final_warning[s]);
+    }
+    EC_tt_expect(Rx->Case, "wrong frames applied", Rx->Wrong, 0);
+}
+
+int main(int argc, char **argv)
+{
+    static EC_tt_rx_t rx[TT_JOINS];
+    size_t offsets[TT_JOINS] = {0};
+    uint64_t seed = (argc > 1) ? strtoull(argv[1], NULL, 0) : 1;
+
+    EC_tt_generate(seed);
+    printf("%u frames, %zu bytes for %u periods x %u sources\n", tt_num_frames, tt_stream_size, TT_PERIODS,
+           TT_SOURCES);
+
+    EC_tt_rxInit(&rx[0], "clean", 0);
+    EC_tt_run(rx, 1, offsets, seed, 0);
+    EC_tt_expectFinal(&rx[0]);
+    EC_tt_expect("clean", "Frames", rx[0].Decoder.Frames, tt_num_frames);
+    EC_tt_expect("clean", "Corrupt", rx[0].Decoder.Corrupt, 0);
+    EC_tt_expect("clean", "Lost", rx[0].Decoder.Lost, 0);
+    EC_tt_expect("clean", "Unsynced", rx[0].Decoder.Unsynced, 0);
+
+    EC_tt_rxInit(&rx[0], "corrupt", 0);
+    EC_tt_run(rx, 1, offsets, seed, 1);
+    EC_tt_expectFinal(&rx[0]);
+    EC_tt_expect("corrupt", "corruption detected", rx[0].Decoder.Corrupt > 0, 1);
+    EC_tt_expect("corrupt", "most frames applied", rx[0].Decoder.Frames > tt_num_frames * 8u / 10u, 1);
+    printf("corrupt: %u applied, %u corrupt, %u lost, %u unsynced\n", rx[0].Decoder.Frames, rx[0].Decoder.Corrupt,
+           rx[0].Decoder.Lost, rx[0].Decoder.Unsynced);
+
+    uint64_t rng = seed;
+    for (uint32_t r = 0; r < TT_JOINS; r++)
+    {
+        offsets[r] = EC_tt_random(&rng) % (tt_stream_size / 2u);
+        EC_tt_rxInit(&rx[r], "join", offsets[r]);
+    }
+    EC_tt_run(rx, TT_JOINS, offsets, seed, 0);
+    for (uint32_t r = 0; r < TT_JOINS; r++)
+    {
+        EC_tt_expectFinal(&rx[r]);
+        EC_tt_expect("join", "first applied frame a delta", rx[r].FirstNotKeyframe, 0);
+        // Only the partial frame at the join point may be corrupt
+        EC_tt_expect("join", "Corrupt <= 1", rx[r].Decoder.Corrupt <= 1u, 1);
+    }
+
+    printf("%s\n", tt_failures ? "FAILED" : "OK");
+
+    return tt_failures ? 1 : 0;
+}